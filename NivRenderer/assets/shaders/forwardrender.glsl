@@ -4,11 +4,7 @@
 
 #ifdef VERTEX
 
-layout (location = 0) in vec3 vertPosition;
-layout (location = 1) in vec3 vertNormal;
-layout (location = 2) in vec2 vertTextureCoords;
-layout (location = 3) in vec3 vertTangent;
-layout (location = 4) in vec3 vertBitangent;
+#include "vertexformat.glsl"
 
 out vec2 v_TextureCoords;
 out vec3 v_Normal;
@@ -20,13 +16,14 @@ out mat3 v_TBN;
 
 void main()
 {
-    v_TextureCoords = vertTextureCoords;
-    v_Normal = mat3(transpose(inverse(model))) * vertNormal;
-    v_FragPos = vec3(model * vec4(vertPosition, 1.0));
+    Vertex vertex = loadVertex();
+    v_TextureCoords = vertex.textureCoords;
+    v_Normal = mat3(transpose(inverse(model))) * vertex.normal;
+    v_FragPos = vec3(model * vec4(vertex.position, 1.0));
     v_FragPosLightSpace = lightSpaceMatrix * vec4(v_FragPos, 1.0);
-    vec3 T = normalize(vec3(model * vec4(vertTangent, 0.0)));
-    vec3 B = normalize(vec3(model * vec4(vertBitangent, 0.0)));
-    vec3 N = normalize(vec3(model * vec4(vertNormal, 0.0)));
+    vec3 T = normalize(vec3(model * vec4(vertex.tangent, 0.0)));
+    vec3 B = normalize(vec3(model * vec4(vertex.bitangent, 0.0)));
+    vec3 N = normalize(vec3(model * vec4(vertex.normal, 0.0)));
     v_TBN = mat3(T, B, N);
     gl_Position = viewProjection * vec4(v_FragPos, 1.0);
 }
@@ -80,11 +77,11 @@ void main()
     }
     vec3 V = normalize(viewPos - v_FragPos);
 
-    vec3 albedo = pow(texture(diffuseTexture, v_TextureCoords).rgb, vec3(2.2)); // sRGB->RGB
+    vec3 albedo = texture(diffuseTexture, v_TextureCoords).rgb; // sRGB texture, decoded on sampling
     float metallic = texture(metallicTexture, v_TextureCoords).r;
     float roughness = texture(roughnessTexture, v_TextureCoords).r;
     float ao = texture(aoTexture, v_TextureCoords).r;
-    vec3 emissive = pow(texture(emissiveTexture, v_TextureCoords).rgb, vec3(2.2)); // sRGB->RGB
+    vec3 emissive = texture(emissiveTexture, v_TextureCoords).rgb; // sRGB texture, decoded on sampling
 
     vec3 F0 = vec3(0.04); 
     F0 = mix(F0, albedo, metallic);
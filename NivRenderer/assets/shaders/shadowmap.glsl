@@ -2,13 +2,13 @@
 
 #ifdef VERTEX
 
-layout (location = 0) in vec3 vertPosition;
+#include "vertexformat.glsl"
 
 #include "shareduniforms.glsl"
 
 void main()
 {
-    gl_Position = lightSpaceMatrix * model * vec4(vertPosition, 1.0);
+    gl_Position = lightSpaceMatrix * model * vec4(loadVertexPosition(), 1.0);
 }
 
 #endif
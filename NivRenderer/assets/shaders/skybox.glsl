@@ -28,10 +28,14 @@ out vec4 FragColor;
 in vec3 v_TextureCoords;
 
 uniform samplerCube skybox;
+uniform int isHdr;
 
 void main()
 {
     vec3 color = texture(skybox, v_TextureCoords).rgb;
+    // HDR tonemapping, same as for the lit scene
+    if (isHdr == 1)
+        color = color / (color + vec3(1.0));
     // gamma correct
     color = pow(color, vec3(1.0/2.2));
 
@@ -0,0 +1,63 @@
+// Vertex inputs of both mesh vertex formats, see MeshVertexFormat. Only the attributes of the bound format are enabled.
+layout (location = 0) in vec3 vertPosition;
+layout (location = 1) in vec3 vertNormal;
+layout (location = 2) in vec2 vertTextureCoords;
+layout (location = 3) in vec3 vertTangent;
+layout (location = 4) in vec3 vertBitangent;
+
+layout (location = 5) in vec4 packedPosition; // xyz quantized to the mesh bounds, w bitangent sign (0 = negative)
+layout (location = 6) in vec4 packedNormalTangent; // octahedral normal (xy) and tangent (zw)
+layout (location = 7) in vec2 packedTextureCoords;
+
+#define VERTEX_FORMAT_FULL 0
+#define VERTEX_FORMAT_PACKED 1
+
+uniform int vertexFormat;
+uniform vec3 positionOffset;
+uniform vec3 positionScale;
+
+struct Vertex
+{
+    vec3 position;
+    vec3 normal;
+    vec2 textureCoords;
+    vec3 tangent;
+    vec3 bitangent;
+};
+
+vec3 decodeOctahedral(vec2 encoded)
+{
+    vec3 v = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+    float t = max(-v.z, 0.0);
+    v.x += v.x >= 0.0 ? -t : t;
+    v.y += v.y >= 0.0 ? -t : t;
+    return normalize(v);
+}
+
+vec3 loadVertexPosition()
+{
+    if (vertexFormat == VERTEX_FORMAT_PACKED)
+        return positionOffset + packedPosition.xyz * positionScale;
+    return vertPosition;
+}
+
+Vertex loadVertex()
+{
+    Vertex vertex;
+    vertex.position = loadVertexPosition();
+    if (vertexFormat == VERTEX_FORMAT_PACKED)
+    {
+        vertex.normal = decodeOctahedral(packedNormalTangent.xy);
+        vertex.tangent = decodeOctahedral(packedNormalTangent.zw);
+        vertex.textureCoords = packedTextureCoords;
+        vertex.bitangent = cross(vertex.normal, vertex.tangent) * (packedPosition.w * 2.0 - 1.0);
+    }
+    else
+    {
+        vertex.normal = vertNormal;
+        vertex.tangent = vertTangent;
+        vertex.textureCoords = vertTextureCoords;
+        vertex.bitangent = vertBitangent;
+    }
+    return vertex;
+}
@@ -1,20 +1,25 @@
 #include "Scene.h"
 
 #include "Entity/ECSRegistry.h"
+#include "Entity/View.h"
 #include "Entity/Components/TransformComponent.h"
 #include "Entity/Components/MeshComponent.h"
 #include "Entity/Components/MaterialComponent.h"
 
+#include <ranges>
+
 Scene::Scene()
     : m_Id(IdManager::GetInstance().CreateNewId()), m_CameraId(UINT32_MAX), m_SkyboxId(UINT32_MAX)
 {
     m_SceneSettings.visualizeLights = false;
     m_SceneSettings.animateDirectionalLight = false;
+    m_SceneSettings.meshletCulling = true;
     m_SceneSettings.renderResolution = {1920, 1080};
     m_SceneSettings.tempRenderResolution = {1920, 1080};
     m_SceneSettings.shadowmapResolution = {1024, 1024};
     m_SceneSettings.tempShadowmapResolution = {1024, 1024};
     m_SceneSettings.sampleCount = 4;
+    m_SceneSettings.textureMemoryBudget = 2048;
     m_HasDirectionalLight = false;
     m_HasSkybox = false;
 }
@@ -98,27 +103,30 @@ void Scene::RemoveMaterialAsset(uint32_t materialAssetId) const
 {
     //Remove Material from all SceneObjects that use it (Set Material back to Default)
     const auto defaultMaterial = AssetManager::GetInstance().GetMaterial("Default");
-    for(const uint32_t sceneObjectId : m_SceneObjectIds)
+    for (auto [entityId, materialComponent] : View<MaterialComponent>())
     {
-        const auto sceneObject = ECSRegistry::GetInstance().GetEntity<SceneObject>(sceneObjectId);
-        const auto materialComponent = ECSRegistry::GetInstance().GetComponent<MaterialComponent>(sceneObjectId);
-        if (materialComponent->GetMaterialAsset()->GetId() != materialAssetId)
+        if (!materialComponent.GetMaterialAsset() || materialComponent.GetMaterialAsset()->GetId() != materialAssetId)
             continue;
 
-        materialComponent->SetMaterialAsset(defaultMaterial);
-        if (const auto model = AssetManager::GetInstance().GetModel(*sceneObject->GetModelPath()))
+        materialComponent.SetMaterialAsset(defaultMaterial);
+        ECSRegistry::GetInstance().MarkChanged<MaterialComponent>(entityId);
+    }
+
+    // Objects created from the models later on get the default material as well
+    for (const auto& model : AssetManager::GetInstance().GetModels() | std::views::values)
+    {
+        std::vector<std::vector<SubModel>*> pendingSubModels = {&model->subModels};
+        while (!pendingSubModels.empty())
         {
-            auto& subModels = model->subModels;
-            while (!subModels.empty())
+            const auto subModels = pendingSubModels.back();
+            pendingSubModels.pop_back();
+            for (auto& subModel : *subModels)
             {
-                for (auto& subModel : subModels)
-                {
-                    if (subModel.material->GetId() == materialAssetId)
-                        subModel.material = defaultMaterial;
-                }
+                if (subModel.material.id == materialAssetId)
+                    subModel.material = AssetManager::GetInstance().GetMaterialHandle(defaultMaterial->GetId());
+                pendingSubModels.push_back(&subModel.subModels);
             }
         }
-        sceneObject->SetDirtyFlag(true);
     }
 
     //Remove Material itself
@@ -140,6 +148,7 @@ std::vector<std::pair<std::string, Property>> Scene::GetEntityProperties()
     returnVector.push_back({"General Scene Settings", {PropertyType::SEPARATORTEXT, nullptr, [this]() {}}});
     returnVector.push_back({"Visualize Lights", {PropertyType::BOOL, &m_SceneSettings.visualizeLights, [this]() {}}});
     returnVector.push_back({"Animate Directional Light", {PropertyType::BOOL, &m_SceneSettings.animateDirectionalLight, [this]() {}}});
+    returnVector.push_back({"Meshlet Culling", {PropertyType::BOOL, &m_SceneSettings.meshletCulling, [this]() {}}});
     returnVector.push_back({"Render Resolution", {PropertyType::INT2, glm::value_ptr(m_SceneSettings.tempRenderResolution), [this]() {}}});
     returnVector.push_back({"Shadowmap Resolution",{PropertyType::INT2, glm::value_ptr(m_SceneSettings.tempShadowmapResolution), [this]() {}}});
     returnVector.push_back({"Apply resolution", {PropertyType::BUTTON, nullptr, [this]() {
@@ -148,6 +157,28 @@ std::vector<std::pair<std::string, Property>> Scene::GetEntityProperties()
     }}});
     returnVector.push_back({"Sample count", {PropertyType::INT, &m_SceneSettings.sampleCount, [this]() {}}});
 
+    TextureSizePolicy& sizePolicy = m_SceneSettings.textureSizePolicy;
+    const auto applySizePolicy = [this]() {
+        AssetManager::GetInstance().SetTextureSizePolicy(m_SceneSettings.textureSizePolicy);
+    };
+    returnVector.push_back({"Texture Size Policy", {PropertyType::SEPARATORTEXT, nullptr, [this]() {}}});
+    returnVector.push_back({"Max Texture Size", {PropertyType::INT, &sizePolicy.maxDimension, applySizePolicy}});
+    returnVector.push_back({"Round To Power Of Two", {PropertyType::BOOL, &sizePolicy.roundToPowerOfTwo, applySizePolicy}});
+    returnVector.push_back({"Max Normal Size", {PropertyType::INT, &sizePolicy.slotMaxDimensions[static_cast<size_t>(MaterialTextureSlot::NORMAL)], applySizePolicy}});
+    returnVector.push_back({"Max Metallic Size", {PropertyType::INT, &sizePolicy.slotMaxDimensions[static_cast<size_t>(MaterialTextureSlot::METALLIC)], applySizePolicy}});
+    returnVector.push_back({"Max Roughness Size", {PropertyType::INT, &sizePolicy.slotMaxDimensions[static_cast<size_t>(MaterialTextureSlot::ROUGHNESS)], applySizePolicy}});
+    returnVector.push_back({"Max AO Size", {PropertyType::INT, &sizePolicy.slotMaxDimensions[static_cast<size_t>(MaterialTextureSlot::AO)], applySizePolicy}});
+    returnVector.push_back({"Texture Memory Budget (MiB)", {PropertyType::INT, &m_SceneSettings.textureMemoryBudget, [this]() {}}});
+
+    ResidencyPolicy& residencyPolicy = m_SceneSettings.residencyPolicy;
+    const auto applyResidencyPolicy = [this]() {
+        AssetManager::GetInstance().SetResidencyPolicy(m_SceneSettings.residencyPolicy);
+    };
+    returnVector.push_back({"CPU Residency (0 Keep, 1 After Upload, 2 Under Pressure)", {PropertyType::SEPARATORTEXT, nullptr, [this]() {}}});
+    returnVector.push_back({"Mesh Residency", {PropertyType::INT, &residencyPolicy.meshResidency, applyResidencyPolicy}});
+    returnVector.push_back({"Texture Residency", {PropertyType::INT, &residencyPolicy.textureResidency, applyResidencyPolicy}});
+    returnVector.push_back({"CPU Memory Budget (MiB)", {PropertyType::INT, &residencyPolicy.cpuMemoryBudget, applyResidencyPolicy}});
+
     return returnVector;
 }
 
@@ -158,9 +189,13 @@ nlohmann::ordered_json Scene::SerializeObject()
     scene["SceneSettings"] = {
         {"VisualizeLights", m_SceneSettings.visualizeLights},
         {"AnimateDirectionalLight", m_SceneSettings.animateDirectionalLight},
+        {"MeshletCulling", m_SceneSettings.meshletCulling},
         {"RenderResolution", {{"x", m_SceneSettings.renderResolution.x}, {"y", m_SceneSettings.renderResolution.y}}},
         {"ShadowmapResolution", {{"x", m_SceneSettings.shadowmapResolution.x}, {"y", m_SceneSettings.shadowmapResolution.y}}},
-        {"SampleCount", m_SceneSettings.sampleCount}
+        {"SampleCount", m_SceneSettings.sampleCount},
+        {"TextureSizePolicy", m_SceneSettings.textureSizePolicy.SerializeObject()},
+        {"TextureMemoryBudget", m_SceneSettings.textureMemoryBudget},
+        {"ResidencyPolicy", m_SceneSettings.residencyPolicy.SerializeObject()}
     };
 
     scene["CurrentId"] = IdManager::GetInstance().GetCurrentId();
@@ -204,8 +239,19 @@ nlohmann::ordered_json Scene::SerializeObject()
 
     scene["Assets"]["MeshAssets"] = json::array();
     i = 0;
+    // Released mesh data is restored from the model cache first, all meshes in parallel
+    std::vector<MeshAsset*> meshAssets;
+    for (const auto& m : AssetManager::GetInstance().GetMeshes())
+        meshAssets.push_back(m.second);
+    AssetManager::GetInstance().LoadMeshDataAsync(meshAssets);
     for (const auto& m : AssetManager::GetInstance().GetMeshes())
     {
+        // Writing the mesh without its data would destroy it in the saved scene
+        if (!AssetManager::GetInstance().RequireMeshData(m.second))
+        {
+            SPDLOG_ERROR("Could not save the scene, the data of mesh " + m.first + " could not be restored");
+            return ordered_json();
+        }
         ordered_json mesh = m.second->SerializeObject();
         mesh["Path"] = m.first;
         scene["Assets"]["MeshAssets"][i] = mesh;
@@ -231,11 +277,22 @@ void Scene::DeSerializeObject(nlohmann::json jsonObject)
     json sceneSettings = jsonObject["SceneSettings"];
     m_SceneSettings.visualizeLights = sceneSettings["VisualizeLights"];
     m_SceneSettings.animateDirectionalLight = sceneSettings["AnimateDirectionalLight"];
+    if (sceneSettings.contains("MeshletCulling"))
+        m_SceneSettings.meshletCulling = sceneSettings["MeshletCulling"];
     m_SceneSettings.renderResolution = { sceneSettings["RenderResolution"]["x"], sceneSettings["RenderResolution"]["y"] };
     m_SceneSettings.tempRenderResolution = {sceneSettings["RenderResolution"]["x"], sceneSettings["RenderResolution"]["y"]};
     m_SceneSettings.shadowmapResolution = {sceneSettings["ShadowmapResolution"]["x"], sceneSettings["ShadowmapResolution"]["y"]};
     m_SceneSettings.tempShadowmapResolution = {sceneSettings["ShadowmapResolution"]["x"], sceneSettings["ShadowmapResolution"]["y"]};
     m_SceneSettings.sampleCount = sceneSettings["SampleCount"];
+    if (sceneSettings.contains("TextureSizePolicy"))
+        m_SceneSettings.textureSizePolicy.DeSerializeObject(sceneSettings["TextureSizePolicy"]);
+    if (sceneSettings.contains("TextureMemoryBudget"))
+        m_SceneSettings.textureMemoryBudget = sceneSettings["TextureMemoryBudget"];
+    if (sceneSettings.contains("ResidencyPolicy"))
+        m_SceneSettings.residencyPolicy.DeSerializeObject(sceneSettings["ResidencyPolicy"]);
+    AssetManager::GetInstance().SetResidencyPolicy(m_SceneSettings.residencyPolicy);
+    // Has to be set before the textures get loaded, they are imported with the policy of the scene
+    AssetManager::GetInstance().SetTextureSizePolicy(m_SceneSettings.textureSizePolicy);
 
     json textureAssets = jsonObject["Assets"]["TextureAssets"];
     for (json texture : textureAssets)
@@ -4,17 +4,24 @@
 #include "Entity/Entities/LightObject.h"
 #include "Entity/Entities/CameraObject.h"
 #include "Entity/Entities/SkyboxObject.h"
+#include "Entity/Assets/TextureSizePolicy.h"
+#include "Entity/Assets/ResidencyPolicy.h"
 #include "nlohmann/json.hpp"
 
 struct SceneSettings
 {
     bool visualizeLights;
     bool animateDirectionalLight;
+    bool meshletCulling;
     glm::ivec2 renderResolution;
     glm::ivec2 tempRenderResolution;
     glm::ivec2 shadowmapResolution;
     glm::ivec2 tempShadowmapResolution;
     uint32_t sampleCount;
+    TextureSizePolicy textureSizePolicy;
+    // In MiB, textures that weren't drawn for the longest time get evicted from the GPU above it. 0 disables eviction
+    int32_t textureMemoryBudget;
+    ResidencyPolicy residencyPolicy;
 };
 
 class Scene
@@ -11,8 +11,11 @@ void SerializationManager::SaveSceneToFile(Scene* const scene)
             destination.find_last_of('.') == std::string::npos ? "" : destination.substr(destination.find_last_of('.'), destination.size());
         if (fileEnding != ".nivproj")
             destination += ".nivproj";
-        std::ofstream oStream(destination);
+        // Serialized before the file is opened, so a failed save leaves an existing file untouched
         const nlohmann::ordered_json sceneJson = scene->SerializeObject();
+        if (sceneJson.is_null())
+            return;
+        std::ofstream oStream(destination);
         oStream << sceneJson;
         oStream.close();   
     }
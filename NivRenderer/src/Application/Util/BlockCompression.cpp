@@ -0,0 +1,306 @@
+#include "Application/Util/BlockCompression.h"
+
+#include <cstring>
+
+namespace
+{
+    constexpr int32_t BC7_WEIGHTS[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+    struct BitWriter
+    {
+        unsigned char* data;
+        uint32_t bitPosition = 0;
+
+        void Write(const uint32_t value, const uint32_t bitCount)
+        {
+            for (uint32_t i = 0; i < bitCount; i++)
+            {
+                if ((value >> i) & 1)
+                    data[bitPosition >> 3] |= static_cast<unsigned char>(1 << (bitPosition & 7));
+                bitPosition++;
+            }
+        }
+    };
+
+    // Gathers a 4x4 block as RGBA, clamping at the image border and filling missing channels like OpenGL does
+    void fetchBlock(const unsigned char* pixels, const int32_t width, const int32_t height, const int32_t nrComponents,
+                    const int32_t blockX, const int32_t blockY, unsigned char* rgba)
+    {
+        for (int32_t y = 0; y < 4; y++)
+        {
+            const int32_t sourceY = std::min(blockY * 4 + y, height - 1);
+            for (int32_t x = 0; x < 4; x++)
+            {
+                const int32_t sourceX = std::min(blockX * 4 + x, width - 1);
+                const unsigned char* source = pixels + (static_cast<size_t>(sourceY) * width + sourceX) * nrComponents;
+                unsigned char* target = rgba + (y * 4 + x) * 4;
+                target[0] = source[0];
+                target[1] = nrComponents > 1 ? source[1] : 0;
+                target[2] = nrComponents > 2 ? source[2] : 0;
+                target[3] = nrComponents > 3 ? source[3] : 255;
+            }
+        }
+    }
+
+    void compressBC4Block(const unsigned char* rgba, const int32_t channel, unsigned char* output)
+    {
+        int32_t minValue = 255, maxValue = 0;
+        for (int32_t i = 0; i < 16; i++)
+        {
+            minValue = std::min(minValue, static_cast<int32_t>(rgba[i * 4 + channel]));
+            maxValue = std::max(maxValue, static_cast<int32_t>(rgba[i * 4 + channel]));
+        }
+
+        std::memset(output, 0, 8);
+        output[0] = static_cast<unsigned char>(maxValue);
+        output[1] = static_cast<unsigned char>(minValue);
+        if (minValue == maxValue)
+            return;
+
+        // With a0 > a1 the palette is a0, a1 followed by six evenly spaced values from a0 towards a1
+        const int32_t range = maxValue - minValue;
+        uint64_t indices = 0;
+        for (int32_t i = 0; i < 16; i++)
+        {
+            const int32_t step = ((maxValue - rgba[i * 4 + channel]) * 7 + range / 2) / range;
+            const uint64_t index = step == 0 ? 0 : step == 7 ? 1 : step + 1;
+            indices |= index << (3 * i);
+        }
+        for (int32_t i = 0; i < 6; i++)
+            output[2 + i] = static_cast<unsigned char>(indices >> (8 * i));
+    }
+
+    void computeEndpoints(const unsigned char* rgba, float* endpoint0, float* endpoint1)
+    {
+        float mean[4] = {};
+        for (int32_t i = 0; i < 16; i++)
+            for (int32_t c = 0; c < 4; c++)
+                mean[c] += rgba[i * 4 + c] / 16.0f;
+
+        float covariance[4][4] = {};
+        for (int32_t i = 0; i < 16; i++)
+        {
+            float difference[4];
+            for (int32_t c = 0; c < 4; c++)
+                difference[c] = rgba[i * 4 + c] - mean[c];
+            for (int32_t a = 0; a < 4; a++)
+                for (int32_t b = 0; b < 4; b++)
+                    covariance[a][b] += difference[a] * difference[b];
+        }
+
+        // Principal axis through power iteration
+        float axis[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+        for (int32_t iteration = 0; iteration < 8; iteration++)
+        {
+            float next[4] = {};
+            for (int32_t a = 0; a < 4; a++)
+                for (int32_t b = 0; b < 4; b++)
+                    next[a] += covariance[a][b] * axis[b];
+            const float length = std::sqrt(next[0] * next[0] + next[1] * next[1] + next[2] * next[2] + next[3] * next[3]);
+            if (length < 1e-6f)
+                break;
+            for (int32_t c = 0; c < 4; c++)
+                axis[c] = next[c] / length;
+        }
+
+        float minProjection = FLT_MAX, maxProjection = -FLT_MAX;
+        for (int32_t i = 0; i < 16; i++)
+        {
+            float projection = 0.0f;
+            for (int32_t c = 0; c < 4; c++)
+                projection += (rgba[i * 4 + c] - mean[c]) * axis[c];
+            minProjection = std::min(minProjection, projection);
+            maxProjection = std::max(maxProjection, projection);
+        }
+
+        for (int32_t c = 0; c < 4; c++)
+        {
+            endpoint0[c] = std::clamp(mean[c] + axis[c] * minProjection, 0.0f, 255.0f);
+            endpoint1[c] = std::clamp(mean[c] + axis[c] * maxProjection, 0.0f, 255.0f);
+        }
+    }
+
+    // Picks the palette index for every pixel and returns the squared error
+    int32_t selectBC7Indices(const unsigned char* rgba, const int32_t* endpoint0, const int32_t* endpoint1,
+                             uint8_t* indices)
+    {
+        int32_t palette[16][4];
+        for (int32_t i = 0; i < 16; i++)
+            for (int32_t c = 0; c < 4; c++)
+                palette[i][c] = ((64 - BC7_WEIGHTS[i]) * endpoint0[c] + BC7_WEIGHTS[i] * endpoint1[c] + 32) >> 6;
+
+        int32_t direction[4];
+        int32_t directionLengthSquared = 0;
+        for (int32_t c = 0; c < 4; c++)
+        {
+            direction[c] = endpoint1[c] - endpoint0[c];
+            directionLengthSquared += direction[c] * direction[c];
+        }
+
+        int32_t totalError = 0;
+        for (int32_t i = 0; i < 16; i++)
+        {
+            const unsigned char* pixel = rgba + i * 4;
+            int32_t guess = 0;
+            if (directionLengthSquared > 0)
+            {
+                int32_t projection = 0;
+                for (int32_t c = 0; c < 4; c++)
+                    projection += (pixel[c] - endpoint0[c]) * direction[c];
+                guess = std::clamp((projection * 15 + directionLengthSquared / 2) / directionLengthSquared, 0, 15);
+            }
+
+            // The weights are not perfectly even, so check the neighbours of the projected index as well
+            int32_t bestError = INT32_MAX;
+            for (int32_t candidate = std::max(0, guess - 1); candidate <= std::min(15, guess + 1); candidate++)
+            {
+                int32_t error = 0;
+                for (int32_t c = 0; c < 4; c++)
+                {
+                    const int32_t difference = pixel[c] - palette[candidate][c];
+                    error += difference * difference;
+                }
+                if (error < bestError)
+                {
+                    bestError = error;
+                    indices[i] = static_cast<uint8_t>(candidate);
+                }
+            }
+            totalError += bestError;
+        }
+
+        return totalError;
+    }
+
+    void compressBC7Block(const unsigned char* rgba, unsigned char* output)
+    {
+        float endpoint0[4], endpoint1[4];
+        computeEndpoints(rgba, endpoint0, endpoint1);
+
+        // Mode 6 stores 7 bit endpoints plus one shared p-bit per endpoint, try all p-bit combinations
+        int32_t bestError = INT32_MAX;
+        int32_t bestQuantized0[4] = {}, bestQuantized1[4] = {};
+        int32_t bestPBit0 = 0, bestPBit1 = 0;
+        uint8_t bestIndices[16] = {};
+        for (int32_t pBit0 = 0; pBit0 < 2; pBit0++)
+        {
+            for (int32_t pBit1 = 0; pBit1 < 2; pBit1++)
+            {
+                int32_t quantized0[4], quantized1[4], expanded0[4], expanded1[4];
+                for (int32_t c = 0; c < 4; c++)
+                {
+                    quantized0[c] = std::clamp(static_cast<int32_t>(std::lround((endpoint0[c] - pBit0) / 2.0f)), 0, 127);
+                    quantized1[c] = std::clamp(static_cast<int32_t>(std::lround((endpoint1[c] - pBit1) / 2.0f)), 0, 127);
+                    expanded0[c] = (quantized0[c] << 1) | pBit0;
+                    expanded1[c] = (quantized1[c] << 1) | pBit1;
+                }
+
+                uint8_t indices[16];
+                const int32_t error = selectBC7Indices(rgba, expanded0, expanded1, indices);
+                if (error < bestError)
+                {
+                    bestError = error;
+                    std::memcpy(bestQuantized0, quantized0, sizeof(quantized0));
+                    std::memcpy(bestQuantized1, quantized1, sizeof(quantized1));
+                    std::memcpy(bestIndices, indices, sizeof(indices));
+                    bestPBit0 = pBit0;
+                    bestPBit1 = pBit1;
+                }
+            }
+        }
+
+        // The anchor index is stored with one bit less, so its highest bit has to be zero
+        if (bestIndices[0] & 8)
+        {
+            std::swap(bestQuantized0, bestQuantized1);
+            std::swap(bestPBit0, bestPBit1);
+            for (auto& index : bestIndices)
+                index = static_cast<uint8_t>(15 - index);
+        }
+
+        std::memset(output, 0, 16);
+        BitWriter writer{output};
+        writer.Write(1 << 6, 7);
+        for (int32_t c = 0; c < 4; c++)
+        {
+            writer.Write(bestQuantized0[c], 7);
+            writer.Write(bestQuantized1[c], 7);
+        }
+        writer.Write(bestPBit0, 1);
+        writer.Write(bestPBit1, 1);
+        writer.Write(bestIndices[0], 3);
+        for (int32_t i = 1; i < 16; i++)
+            writer.Write(bestIndices[i], 4);
+    }
+}
+
+namespace BlockCompression
+{
+    Format ChooseFormat(const int32_t nrComponents)
+    {
+        switch (nrComponents)
+        {
+        case 1:
+            return Format::BC4;
+        case 2:
+            return Format::BC5;
+        default:
+            return Format::BC7;
+        }
+    }
+
+    size_t GetBlockSize(const Format format)
+    {
+        switch (format)
+        {
+        case Format::BC4:
+            return 8;
+        case Format::BC5:
+        case Format::BC7:
+            return 16;
+        case Format::NONE:
+        default:
+            return 0;
+        }
+    }
+
+    size_t GetCompressedSize(const Format format, const int32_t width, const int32_t height)
+    {
+        const size_t blockCountX = (width + 3) / 4;
+        const size_t blockCountY = (height + 3) / 4;
+        return blockCountX * blockCountY * GetBlockSize(format);
+    }
+
+    void CompressImage(const Format format, const unsigned char* pixels, const int32_t width, const int32_t height,
+                       const int32_t nrComponents, unsigned char* output)
+    {
+        const int32_t blockCountX = (width + 3) / 4;
+        const int32_t blockCountY = (height + 3) / 4;
+        const size_t blockSize = GetBlockSize(format);
+
+        unsigned char rgba[64];
+        for (int32_t blockY = 0; blockY < blockCountY; blockY++)
+        {
+            for (int32_t blockX = 0; blockX < blockCountX; blockX++)
+            {
+                fetchBlock(pixels, width, height, nrComponents, blockX, blockY, rgba);
+                unsigned char* block = output + (static_cast<size_t>(blockY) * blockCountX + blockX) * blockSize;
+                switch (format)
+                {
+                case Format::BC4:
+                    compressBC4Block(rgba, 0, block);
+                    break;
+                case Format::BC5:
+                    compressBC4Block(rgba, 0, block);
+                    compressBC4Block(rgba, 1, block + 8);
+                    break;
+                case Format::BC7:
+                    compressBC7Block(rgba, block);
+                    break;
+                case Format::NONE:
+                    break;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include "Base.h"
+
+// Minimal BC4/BC5/BC7 encoders used for baking textures. BC7 only uses mode 6 (single subset RGBA),
+// which is fast to encode and still clearly better than BC1/BC3 on most material textures.
+namespace BlockCompression
+{
+    enum class Format : uint32_t
+    {
+        NONE = 0,
+        BC4 = 1,
+        BC5 = 2,
+        BC7 = 3
+    };
+
+    Format ChooseFormat(int32_t nrComponents);
+    size_t GetBlockSize(Format format);
+    size_t GetCompressedSize(Format format, int32_t width, int32_t height);
+
+    // Compresses a tightly packed 8-bit image with nrComponents channels into output, which has to hold
+    // GetCompressedSize(format, width, height) bytes
+    void CompressImage(Format format, const unsigned char* pixels, int32_t width, int32_t height, int32_t nrComponents,
+                       unsigned char* output);
+}
@@ -0,0 +1,178 @@
+#pragma once
+#include "Base.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace FileUtils
+{
+    constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+    constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+    inline uint64_t HashFnv1a(const void* data, const size_t size, uint64_t hash = FNV_OFFSET_BASIS)
+    {
+        const auto bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; i++)
+        {
+            hash ^= bytes[i];
+            hash *= FNV_PRIME;
+        }
+
+        return hash;
+    }
+
+    // Word-at-a-time hash for large buffers (file contents, vertex data). Four independent lanes keep the
+    // multiplications from waiting on each other, the tail falls back to FNV-1a.
+    inline uint64_t HashFast(const void* data, const size_t size, const uint64_t seed = FNV_OFFSET_BASIS)
+    {
+        constexpr uint64_t MULTIPLIER = 0x9E3779B97F4A7C15ull;
+        const auto bytes = static_cast<const unsigned char*>(data);
+        uint64_t lanes[4] = {seed, seed ^ MULTIPLIER, seed + FNV_PRIME, seed - MULTIPLIER};
+
+        size_t offset = 0;
+        for (; offset + sizeof(uint64_t) * 4 <= size; offset += sizeof(uint64_t) * 4)
+        {
+            for (size_t lane = 0; lane < 4; lane++)
+            {
+                uint64_t word;
+                memcpy(&word, bytes + offset + lane * sizeof(uint64_t), sizeof(uint64_t));
+                lanes[lane] = (lanes[lane] ^ word) * MULTIPLIER;
+                lanes[lane] ^= lanes[lane] >> 29;
+            }
+        }
+
+        uint64_t hash = HashFnv1a(lanes, sizeof(lanes));
+        hash = HashFnv1a(bytes + offset, size - offset, hash ^ size);
+        // Final avalanche (splitmix64), so similar inputs don't end up with similar hashes
+        hash ^= hash >> 30;
+        hash *= 0xBF58476D1CE4E5B9ull;
+        hash ^= hash >> 27;
+        hash *= 0x94D049BB133111EBull;
+        hash ^= hash >> 31;
+
+        return hash;
+    }
+
+    // Hashes the contents of a file, returns false if it can't be read
+    inline bool HashFile(const std::string& path, uint64_t& hash)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            return false;
+
+        constexpr size_t CHUNK_SIZE = 1024 * 1024;
+        std::vector<char> chunk(CHUNK_SIZE);
+        hash = FNV_OFFSET_BASIS;
+        while (file)
+        {
+            file.read(chunk.data(), CHUNK_SIZE);
+            const auto bytesRead = static_cast<size_t>(file.gcount());
+            if (bytesRead == 0)
+                break;
+            hash = HashFast(chunk.data(), bytesRead, hash);
+        }
+
+        return !file.bad();
+    }
+
+    inline uint64_t HashString(const std::string& string, const uint64_t hash = FNV_OFFSET_BASIS)
+    {
+        return HashFnv1a(string.data(), string.size(), hash);
+    }
+
+    inline std::string ToHexString(const uint64_t value)
+    {
+        char hexString[17];
+        snprintf(hexString, sizeof(hexString), "%016llx", static_cast<unsigned long long>(value));
+        return hexString;
+    }
+
+    // Returns 0 if the file does not exist
+    inline int64_t GetLastWriteTime(const std::string& path)
+    {
+        std::error_code errorCode;
+        const auto writeTime = std::filesystem::last_write_time(path, errorCode);
+        if (errorCode)
+            return 0;
+
+        return static_cast<int64_t>(writeTime.time_since_epoch().count());
+    }
+
+    // Writes a file through a temporary file that is renamed over the destination at the end, so an interrupted write
+    // never leaves a truncated but valid looking file behind. writeContents(std::ofstream&) writes the contents,
+    // returns false if the file could not be written.
+    template <typename Fn>
+    bool WriteFileAtomic(const std::string& path, Fn&& writeContents)
+    {
+        const std::string tempPath = path + ".tmp";
+        std::error_code errorCode;
+        {
+            std::ofstream stream(tempPath, std::ios::binary | std::ios::trunc);
+            if (!stream.is_open())
+                return false;
+
+            writeContents(stream);
+            stream.flush();
+            if (!stream)
+            {
+                stream.close();
+                std::filesystem::remove(tempPath, errorCode);
+                return false;
+            }
+        }
+
+        std::filesystem::rename(tempPath, path, errorCode);
+        if (errorCode)
+        {
+            std::filesystem::remove(tempPath, errorCode);
+            return false;
+        }
+
+        return true;
+    }
+
+    template <typename T>
+    void WriteValue(std::ofstream& stream, const T& value)
+    {
+        stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    inline void WriteString(std::ofstream& stream, const std::string& string)
+    {
+        WriteValue(stream, static_cast<uint32_t>(string.size()));
+        stream.write(string.data(), static_cast<std::streamsize>(string.size()));
+    }
+
+    template <typename T>
+    void WriteVector(std::ofstream& stream, const std::vector<T>& vector)
+    {
+        WriteValue(stream, static_cast<uint32_t>(vector.size()));
+        stream.write(reinterpret_cast<const char*>(vector.data()), static_cast<std::streamsize>(vector.size() * sizeof(T)));
+    }
+
+    template <typename T>
+    bool ReadValue(std::ifstream& stream, T& value)
+    {
+        return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(T)));
+    }
+
+    inline bool ReadString(std::ifstream& stream, std::string& string)
+    {
+        uint32_t size;
+        if (!ReadValue(stream, size))
+            return false;
+        string.resize(size);
+        return static_cast<bool>(stream.read(string.data(), size));
+    }
+
+    template <typename T>
+    bool ReadVector(std::ifstream& stream, std::vector<T>& vector)
+    {
+        uint32_t size;
+        if (!ReadValue(stream, size))
+            return false;
+        vector.resize(size);
+        return static_cast<bool>(
+            stream.read(reinterpret_cast<char*>(vector.data()), static_cast<std::streamsize>(size * sizeof(T))));
+    }
+}
@@ -0,0 +1,114 @@
+#include "Application/Util/FileWatcher.h"
+
+#include "Application/Util/FileUtils.h"
+
+#include <filesystem>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+FileWatcher::FileWatcher() : m_InotifyHandle(inotify_init1(IN_NONBLOCK | IN_CLOEXEC))
+{
+    if (m_InotifyHandle < 0)
+        SPDLOG_DEBUG("Could not initialize inotify, changed files won't be detected");
+}
+
+FileWatcher::~FileWatcher()
+{
+    if (m_InotifyHandle >= 0)
+        close(m_InotifyHandle);
+}
+
+void FileWatcher::Watch(const std::string& path)
+{
+    const std::string normalizedPath = normalizePath(path);
+    m_WatchedFiles[normalizedPath].insert(path);
+    if (m_InotifyHandle < 0)
+        return;
+
+    // Editors often save by writing a new file and renaming it over the old one, which ends watches on the file itself
+    std::string directory = std::filesystem::path(normalizedPath).parent_path().generic_string();
+    if (directory.empty())
+        directory = ".";
+    const int watchHandle = inotify_add_watch(m_InotifyHandle, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+    if (watchHandle < 0)
+    {
+        SPDLOG_DEBUG("Could not watch " + directory);
+        return;
+    }
+    m_WatchedDirectories[watchHandle] = directory;
+}
+
+std::vector<std::string> FileWatcher::PollChanges()
+{
+    std::vector<std::string> changedFiles;
+    if (m_InotifyHandle < 0)
+        return changedFiles;
+
+    std::unordered_set<std::string> changedPaths;
+    alignas(inotify_event) char buffer[4096];
+    ssize_t length;
+    while ((length = read(m_InotifyHandle, buffer, sizeof(buffer))) > 0)
+    {
+        for (const char* data = buffer; data < buffer + length;)
+        {
+            const auto event = reinterpret_cast<const inotify_event*>(data);
+            data += sizeof(inotify_event) + event->len;
+
+            const auto directoryIt = m_WatchedDirectories.find(event->wd);
+            if (directoryIt == m_WatchedDirectories.end() || !event->len)
+                continue;
+            const std::string changedPath = normalizePath(directoryIt->second + '/' + event->name);
+            if (m_WatchedFiles.contains(changedPath))
+                changedPaths.insert(changedPath);
+        }
+    }
+
+    for (const auto& changedPath : changedPaths)
+        changedFiles.insert(changedFiles.end(), m_WatchedFiles[changedPath].begin(), m_WatchedFiles[changedPath].end());
+
+    return changedFiles;
+}
+#else
+FileWatcher::FileWatcher() = default;
+
+FileWatcher::~FileWatcher() = default;
+
+void FileWatcher::Watch(const std::string& path)
+{
+    const std::string normalizedPath = normalizePath(path);
+    m_WatchedFiles[normalizedPath].insert(path);
+    m_WriteTimes.try_emplace(normalizedPath, FileUtils::GetLastWriteTime(normalizedPath));
+}
+
+std::vector<std::string> FileWatcher::PollChanges()
+{
+    std::vector<std::string> changedFiles;
+    // Without change notifications every watched file has to be checked, so only do it a few times per second
+    const auto now = std::chrono::steady_clock::now();
+    if (now - m_LastPoll < std::chrono::milliseconds(500))
+        return changedFiles;
+    m_LastPoll = now;
+
+    for (auto& [normalizedPath, writeTime] : m_WriteTimes)
+    {
+        const int64_t currentWriteTime = FileUtils::GetLastWriteTime(normalizedPath);
+        if (currentWriteTime == writeTime)
+            continue;
+
+        writeTime = currentWriteTime;
+        const auto& paths = m_WatchedFiles[normalizedPath];
+        changedFiles.insert(changedFiles.end(), paths.begin(), paths.end());
+    }
+
+    return changedFiles;
+}
+#endif
+
+std::string FileWatcher::normalizePath(const std::string& path)
+{
+    return std::filesystem::path(path).lexically_normal().generic_string();
+}
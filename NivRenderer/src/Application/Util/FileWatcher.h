@@ -0,0 +1,35 @@
+#pragma once
+#include "Base.h"
+
+#include <chrono>
+#include <unordered_set>
+
+// Reports files that were written since the last poll. On Linux the directories of the watched files are watched with
+// inotify, so polling is a single non-blocking read. Other platforms compare the write times of the watched files.
+// Not thread safe, only use it from the main thread.
+class FileWatcher
+{
+public:
+    FileWatcher();
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    void Watch(const std::string& path);
+    // Returns the changed files as they were passed to Watch, every file at most once
+    std::vector<std::string> PollChanges();
+
+private:
+    // Normalized path -> paths as they were passed to Watch
+    std::unordered_map<std::string, std::unordered_set<std::string>> m_WatchedFiles;
+#ifdef __linux__
+    int m_InotifyHandle;
+    std::unordered_map<int, std::string> m_WatchedDirectories;
+#else
+    std::unordered_map<std::string, int64_t> m_WriteTimes;
+    std::chrono::steady_clock::time_point m_LastPoll;
+#endif
+
+    static std::string normalizePath(const std::string& path);
+};
@@ -0,0 +1,237 @@
+#include "Application/Util/ImageUtils.h"
+
+#include <cstring>
+
+#include "Application/Util/PixelBuffer.h"
+
+namespace
+{
+    struct BoxTap
+    {
+        int32_t first;
+        std::vector<float> weights;
+    };
+
+    // Source pixels and their coverage for each target pixel
+    std::vector<BoxTap> computeTaps(const int32_t size, const int32_t targetSize)
+    {
+        std::vector<BoxTap> taps(targetSize);
+        const float scale = static_cast<float>(size) / static_cast<float>(targetSize);
+        for (int32_t i = 0; i < targetSize; i++)
+        {
+            const float start = i * scale;
+            const float end = std::min((i + 1) * scale, static_cast<float>(size));
+            BoxTap& tap = taps[i];
+            tap.first = static_cast<int32_t>(start);
+            const int32_t count = std::max(static_cast<int32_t>(std::ceil(end)) - tap.first, 1);
+            for (int32_t j = 0; j < count; j++)
+            {
+                const float overlap = std::min(end, static_cast<float>(tap.first + j + 1)) -
+                    std::max(start, static_cast<float>(tap.first + j));
+                tap.weights.push_back(std::max(overlap, 0.0f) / scale);
+            }
+        }
+
+        return taps;
+    }
+
+    // Row of DownsampleHalf without clamping. The channel count is a template parameter, so the channel loop gets
+    // unrolled and the pixel loop has a constant stride the compiler can vectorize.
+    template <int32_t NrComponents>
+    void downsampleRowHalf(const unsigned char* row0, const unsigned char* row1, unsigned char* targetRow,
+                           const int32_t targetWidth)
+    {
+        for (int32_t x = 0; x < targetWidth; x++)
+        {
+            const int32_t offset = x * 2 * NrComponents;
+            for (int32_t c = 0; c < NrComponents; c++)
+            {
+                const int32_t sum = row0[offset + c] + row0[offset + NrComponents + c] + row1[offset + c] +
+                    row1[offset + NrComponents + c];
+                targetRow[x * NrComponents + c] = static_cast<unsigned char>((sum + 2) >> 2);
+            }
+        }
+    }
+
+    void downscaleBox(const unsigned char* source, const int32_t width, const int32_t height, const int32_t nrComponents,
+                      unsigned char* target, const int32_t targetWidth, const int32_t targetHeight)
+    {
+        const std::vector<BoxTap> horizontalTaps = computeTaps(width, targetWidth);
+        const std::vector<BoxTap> verticalTaps = computeTaps(height, targetHeight);
+
+        // Horizontal pass into a float buffer, then the vertical pass straight into the target
+        std::vector<float> horizontal(static_cast<size_t>(targetWidth) * height * nrComponents);
+        for (int32_t y = 0; y < height; y++)
+        {
+            const unsigned char* sourceRow = source + static_cast<size_t>(y) * width * nrComponents;
+            float* targetRow = horizontal.data() + static_cast<size_t>(y) * targetWidth * nrComponents;
+            for (int32_t x = 0; x < targetWidth; x++)
+            {
+                const BoxTap& tap = horizontalTaps[x];
+                for (int32_t c = 0; c < nrComponents; c++)
+                {
+                    float sum = 0.0f;
+                    for (size_t j = 0; j < tap.weights.size(); j++)
+                        sum += sourceRow[(tap.first + j) * nrComponents + c] * tap.weights[j];
+                    targetRow[x * nrComponents + c] = sum;
+                }
+            }
+        }
+
+        const size_t rowSize = static_cast<size_t>(targetWidth) * nrComponents;
+        for (int32_t y = 0; y < targetHeight; y++)
+        {
+            const BoxTap& tap = verticalTaps[y];
+            unsigned char* targetRow = target + y * rowSize;
+            for (size_t i = 0; i < rowSize; i++)
+            {
+                float sum = 0.0f;
+                for (size_t j = 0; j < tap.weights.size(); j++)
+                    sum += horizontal[(tap.first + j) * rowSize + i] * tap.weights[j];
+                targetRow[i] = static_cast<unsigned char>(std::clamp(sum + 0.5f, 0.0f, 255.0f));
+            }
+        }
+    }
+}
+
+namespace ImageUtils
+{
+    void DownsampleHalf(const unsigned char* source, const int32_t width, const int32_t height, const int32_t nrComponents,
+                        unsigned char* target, const int32_t targetWidth, const int32_t targetHeight)
+    {
+        for (int32_t y = 0; y < targetHeight; y++)
+        {
+            const unsigned char* row0 = source + static_cast<size_t>(std::min(y * 2, height - 1)) * width * nrComponents;
+            const unsigned char* row1 = source + static_cast<size_t>(std::min(y * 2 + 1, height - 1)) * width * nrComponents;
+            unsigned char* targetRow = target + static_cast<size_t>(y) * targetWidth * nrComponents;
+            // Common case without clamping
+            if (width == targetWidth * 2 && nrComponents >= 1 && nrComponents <= 4)
+            {
+                switch (nrComponents)
+                {
+                case 1:
+                    downsampleRowHalf<1>(row0, row1, targetRow, targetWidth);
+                    break;
+                case 2:
+                    downsampleRowHalf<2>(row0, row1, targetRow, targetWidth);
+                    break;
+                case 3:
+                    downsampleRowHalf<3>(row0, row1, targetRow, targetWidth);
+                    break;
+                default:
+                    downsampleRowHalf<4>(row0, row1, targetRow, targetWidth);
+                    break;
+                }
+                continue;
+            }
+
+            for (int32_t x = 0; x < targetWidth; x++)
+            {
+                const int32_t x0 = std::min(x * 2, width - 1) * nrComponents;
+                const int32_t x1 = std::min(x * 2 + 1, width - 1) * nrComponents;
+                for (int32_t c = 0; c < nrComponents; c++)
+                {
+                    const int32_t sum = row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c];
+                    targetRow[x * nrComponents + c] = static_cast<unsigned char>((sum + 2) >> 2);
+                }
+            }
+        }
+    }
+
+    void Downscale(const unsigned char* source, int32_t width, int32_t height, const int32_t nrComponents,
+                   unsigned char* target, const int32_t targetWidth, const int32_t targetHeight)
+    {
+        PixelBuffer currentLevel, nextLevel;
+        // Odd sizes would drop the last row/column when halving, those go through the box filter right away
+        while (width >= targetWidth * 2 && height >= targetHeight * 2 && width % 2 == 0 && height % 2 == 0)
+        {
+            const int32_t nextWidth = width / 2;
+            const int32_t nextHeight = height / 2;
+            unsigned char* nextData = target;
+            if (nextWidth != targetWidth || nextHeight != targetHeight)
+            {
+                nextLevel = PixelBuffer::Allocate(static_cast<size_t>(nextWidth) * nextHeight * nrComponents);
+                nextData = nextLevel.GetData();
+            }
+            DownsampleHalf(source, width, height, nrComponents, nextData, nextWidth, nextHeight);
+            if (nextData == target)
+                return;
+
+            std::swap(currentLevel, nextLevel);
+            source = currentLevel.GetData();
+            width = nextWidth;
+            height = nextHeight;
+        }
+
+        if (width == targetWidth && height == targetHeight)
+        {
+            std::memcpy(target, source, static_cast<size_t>(width) * height * nrComponents);
+            return;
+        }
+        downscaleBox(source, width, height, nrComponents, target, targetWidth, targetHeight);
+    }
+
+    void DownsampleHalf(const float* source, const int32_t width, const int32_t height, const int32_t nrComponents,
+                        float* target, const int32_t targetWidth, const int32_t targetHeight)
+    {
+        for (int32_t y = 0; y < targetHeight; y++)
+        {
+            const float* row0 = source + static_cast<size_t>(std::min(y * 2, height - 1)) * width * nrComponents;
+            const float* row1 = source + static_cast<size_t>(std::min(y * 2 + 1, height - 1)) * width * nrComponents;
+            float* targetRow = target + static_cast<size_t>(y) * targetWidth * nrComponents;
+            for (int32_t x = 0; x < targetWidth; x++)
+            {
+                const int32_t x0 = std::min(x * 2, width - 1) * nrComponents;
+                const int32_t x1 = std::min(x * 2 + 1, width - 1) * nrComponents;
+                for (int32_t c = 0; c < nrComponents; c++)
+                    targetRow[x * nrComponents + c] = (row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c]) * 0.25f;
+            }
+        }
+    }
+
+    void EquirectangularToCubeFace(const float* source, const int32_t width, const int32_t height, const int32_t face,
+                                   const int32_t faceSize, const int32_t firstRow, const int32_t lastRow, float* target)
+    {
+        constexpr float PI = 3.14159265358979f;
+        for (int32_t y = firstRow; y < lastRow; y++)
+        {
+            const float t = 2.0f * (static_cast<float>(y) + 0.5f) / static_cast<float>(faceSize) - 1.0f;
+            for (int32_t x = 0; x < faceSize; x++)
+            {
+                const float s = 2.0f * (static_cast<float>(x) + 0.5f) / static_cast<float>(faceSize) - 1.0f;
+                glm::vec3 direction;
+                switch (face)
+                {
+                case 0: direction = {1.0f, -t, -s}; break;
+                case 1: direction = {-1.0f, -t, s}; break;
+                case 2: direction = {s, 1.0f, t}; break;
+                case 3: direction = {s, -1.0f, -t}; break;
+                case 4: direction = {s, -t, 1.0f}; break;
+                default: direction = {-s, -t, -1.0f}; break;
+                }
+                direction = glm::normalize(direction);
+
+                // The first row of the image is the top of the sphere
+                const float u = (0.5f + std::atan2(direction.z, direction.x) / (2.0f * PI)) * width - 0.5f;
+                const float v = (0.5f - std::asin(std::clamp(direction.y, -1.0f, 1.0f)) / PI) * height - 0.5f;
+                const int32_t u0 = static_cast<int32_t>(std::floor(u));
+                const int32_t v0 = static_cast<int32_t>(std::floor(v));
+                const float uWeight = u - static_cast<float>(u0);
+                const float vWeight = v - static_cast<float>(v0);
+                // Wraps around horizontally, clamps at the poles
+                const int32_t columns[2] = {(u0 % width + width) % width, ((u0 + 1) % width + width) % width};
+                const int32_t rows[2] = {std::clamp(v0, 0, height - 1), std::clamp(v0 + 1, 0, height - 1)};
+
+                float* texel = target + (static_cast<size_t>(y) * faceSize + x) * 3;
+                for (int32_t c = 0; c < 3; c++)
+                {
+                    const float top = source[(static_cast<size_t>(rows[0]) * width + columns[0]) * 3 + c] * (1.0f - uWeight) +
+                        source[(static_cast<size_t>(rows[0]) * width + columns[1]) * 3 + c] * uWeight;
+                    const float bottom = source[(static_cast<size_t>(rows[1]) * width + columns[0]) * 3 + c] * (1.0f - uWeight) +
+                        source[(static_cast<size_t>(rows[1]) * width + columns[1]) * 3 + c] * uWeight;
+                    texel[c] = top * (1.0f - vWeight) + bottom * vWeight;
+                }
+            }
+        }
+    }
+}
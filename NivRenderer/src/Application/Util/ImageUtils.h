@@ -0,0 +1,23 @@
+#pragma once
+#include "Base.h"
+
+// Box filters for tightly packed 8-bit images, and the float versions needed for HDR environment maps
+namespace ImageUtils
+{
+    // Halves the image with a 2x2 box filter, odd edges are clamped. Used for mip generation.
+    void DownsampleHalf(const unsigned char* source, int32_t width, int32_t height, int32_t nrComponents,
+                        unsigned char* target, int32_t targetWidth, int32_t targetHeight);
+
+    // Area averaging downscale to an arbitrary smaller size. Halves with DownsampleHalf as long as possible
+    // and only does the remaining step with the (slower) weighted box filter.
+    void Downscale(const unsigned char* source, int32_t width, int32_t height, int32_t nrComponents,
+                   unsigned char* target, int32_t targetWidth, int32_t targetHeight);
+
+    void DownsampleHalf(const float* source, int32_t width, int32_t height, int32_t nrComponents, float* target,
+                        int32_t targetWidth, int32_t targetHeight);
+
+    // Bilinearly samples an equirectangular RGB image for the rows [firstRow, lastRow) of a cube face. Faces are in
+    // OpenGL order (+X, -X, +Y, -Y, +Z, -Z), target points to the first pixel of the face.
+    void EquirectangularToCubeFace(const float* source, int32_t width, int32_t height, int32_t face, int32_t faceSize,
+                                   int32_t firstRow, int32_t lastRow, float* target);
+}
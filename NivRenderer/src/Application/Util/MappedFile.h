@@ -0,0 +1,31 @@
+#pragma once
+#include "Base.h"
+
+// Read-only memory mapping of a whole file, so large buffers (e.g. glTF .bin files) can be read without copying
+// them into memory first. Move-only, the mapping is released in the destructor.
+class MappedFile
+{
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    bool Open(const std::string& path);
+    void Close();
+
+    const unsigned char* GetData() const { return m_Data; }
+    size_t GetSize() const { return m_Size; }
+    bool IsOpen() const { return m_Data != nullptr; }
+
+private:
+    const unsigned char* m_Data;
+    size_t m_Size;
+#ifdef _WIN32
+    void* m_FileHandle;
+    void* m_MappingHandle;
+#endif
+};
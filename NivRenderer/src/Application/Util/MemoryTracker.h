@@ -0,0 +1,63 @@
+#pragma once
+#include "Base.h"
+#include <map>
+
+struct MemoryEntry
+{
+    std::string Name;
+    size_t Size;
+};
+
+// Keeps track of memory allocations per category (e.g. GPU textures) so they can be shown in the UI.
+// Not thread safe, only use it from the main thread.
+class MemoryTracker
+{
+public:
+    MemoryTracker(MemoryTracker const&) = delete;
+    void operator=(MemoryTracker const&) = delete;
+
+    static MemoryTracker& GetInstance()
+    {
+        static MemoryTracker instance;
+
+        return instance;
+    }
+
+    void Track(const std::string& category, const uint32_t id, const std::string& name, const size_t size)
+    {
+        m_Categories[category][id] = {name, size};
+    }
+    void Untrack(const std::string& category, const uint32_t id)
+    {
+        if (m_Categories.contains(category))
+            m_Categories[category].erase(id);
+    }
+
+    size_t GetTotalSize(const std::string& category) const
+    {
+        size_t totalSize = 0;
+        if (const auto it = m_Categories.find(category); it != m_Categories.end())
+        {
+            for (const auto& entry : it->second)
+                totalSize += entry.second.Size;
+        }
+
+        return totalSize;
+    }
+    std::map<std::string, std::map<uint32_t, MemoryEntry>>& GetCategories() { return m_Categories; }
+
+    static std::string FormatSize(const size_t size)
+    {
+        char sizeString[32];
+        if (size >= 1024 * 1024)
+            snprintf(sizeString, sizeof(sizeString), "%.2f MiB", static_cast<double>(size) / (1024.0 * 1024.0));
+        else
+            snprintf(sizeString, sizeof(sizeString), "%.2f KiB", static_cast<double>(size) / 1024.0);
+        return sizeString;
+    }
+
+private:
+    MemoryTracker() {}
+
+    std::map<std::string, std::map<uint32_t, MemoryEntry>> m_Categories;
+};
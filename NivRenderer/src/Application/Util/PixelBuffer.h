@@ -0,0 +1,146 @@
+#pragma once
+#include "Base.h"
+#include <map>
+#include <mutex>
+#include <ranges>
+
+// Recycles large pixel allocations, so decoding a scene's textures does not hit the allocator for every image.
+// Thread safe, textures are decoded on the worker threads.
+class PixelBufferPool
+{
+public:
+    PixelBufferPool(PixelBufferPool const&) = delete;
+    void operator=(PixelBufferPool const&) = delete;
+
+    static PixelBufferPool& GetInstance()
+    {
+        static PixelBufferPool instance;
+
+        return instance;
+    }
+
+    ~PixelBufferPool()
+    {
+        for (const auto data : m_FreeBlocks | std::views::values)
+            delete[] data;
+    }
+
+    unsigned char* Acquire(const size_t size, size_t& capacity)
+    {
+        {
+            std::lock_guard lock(m_Mutex);
+            // Best fit, but don't hand out blocks that are way bigger than needed
+            const auto it = m_FreeBlocks.lower_bound(size);
+            if (it != m_FreeBlocks.end() && it->first <= size * 2)
+            {
+                capacity = it->first;
+                unsigned char* data = it->second;
+                m_PooledBytes -= it->first;
+                m_FreeBlocks.erase(it);
+                return data;
+            }
+        }
+
+        capacity = size;
+        return new unsigned char[size];
+    }
+
+    void Recycle(unsigned char* data, const size_t capacity)
+    {
+        {
+            std::lock_guard lock(m_Mutex);
+            if (capacity >= MIN_POOLED_SIZE && m_PooledBytes + capacity <= MAX_POOLED_BYTES)
+            {
+                m_FreeBlocks.emplace(capacity, data);
+                m_PooledBytes += capacity;
+                return;
+            }
+        }
+
+        delete[] data;
+    }
+
+private:
+    PixelBufferPool() : m_PooledBytes(0) {}
+
+    static constexpr size_t MIN_POOLED_SIZE = 64 * 1024;
+    static constexpr size_t MAX_POOLED_BYTES = 256 * 1024 * 1024;
+
+    std::mutex m_Mutex;
+    std::multimap<size_t, unsigned char*> m_FreeBlocks;
+    size_t m_PooledBytes;
+};
+
+// Move-only owner of pixel data. Memory either comes from the PixelBufferPool or is adopted from a decoder
+// together with the function that frees it, so decoded images never have to be copied.
+class PixelBuffer
+{
+public:
+    using FreeFunction = void (*)(void*);
+
+    PixelBuffer() : m_Data(nullptr), m_Size(0), m_Capacity(0), m_FreeFunction(nullptr) {}
+    ~PixelBuffer() { Reset(); }
+
+    PixelBuffer(const PixelBuffer&) = delete;
+    PixelBuffer& operator=(const PixelBuffer&) = delete;
+
+    PixelBuffer(PixelBuffer&& other) noexcept :
+        m_Data(std::exchange(other.m_Data, nullptr)), m_Size(std::exchange(other.m_Size, 0)),
+        m_Capacity(std::exchange(other.m_Capacity, 0)), m_FreeFunction(std::exchange(other.m_FreeFunction, nullptr))
+    {
+    }
+    PixelBuffer& operator=(PixelBuffer&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Reset();
+            m_Data = std::exchange(other.m_Data, nullptr);
+            m_Size = std::exchange(other.m_Size, 0);
+            m_Capacity = std::exchange(other.m_Capacity, 0);
+            m_FreeFunction = std::exchange(other.m_FreeFunction, nullptr);
+        }
+        return *this;
+    }
+
+    static PixelBuffer Allocate(const size_t size)
+    {
+        PixelBuffer buffer;
+        buffer.m_Data = PixelBufferPool::GetInstance().Acquire(size, buffer.m_Capacity);
+        buffer.m_Size = size;
+        return buffer;
+    }
+
+    static PixelBuffer Adopt(unsigned char* data, const size_t size, const FreeFunction freeFunction)
+    {
+        PixelBuffer buffer;
+        buffer.m_Data = data;
+        buffer.m_Size = size;
+        buffer.m_Capacity = size;
+        buffer.m_FreeFunction = freeFunction;
+        return buffer;
+    }
+
+    void Reset()
+    {
+        if (m_Data)
+        {
+            if (m_FreeFunction)
+                m_FreeFunction(m_Data);
+            else
+                PixelBufferPool::GetInstance().Recycle(m_Data, m_Capacity);
+        }
+        m_Data = nullptr;
+        m_Size = 0;
+        m_Capacity = 0;
+        m_FreeFunction = nullptr;
+    }
+
+    unsigned char* GetData() const { return m_Data; }
+    size_t GetSize() const { return m_Size; }
+    bool IsEmpty() const { return m_Data == nullptr; }
+
+private:
+    unsigned char* m_Data;
+    size_t m_Size, m_Capacity;
+    FreeFunction m_FreeFunction;
+};
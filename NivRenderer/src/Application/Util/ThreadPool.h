@@ -0,0 +1,134 @@
+#pragma once
+#include "Base.h"
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <queue>
+
+class ThreadPool
+{
+public:
+    ThreadPool(ThreadPool const&) = delete;
+    void operator=(ThreadPool const&) = delete;
+
+    static ThreadPool& GetInstance()
+    {
+        static ThreadPool instance;
+
+        return instance;
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard lock(m_Mutex);
+            m_Stopping = true;
+        }
+        m_Condition.notify_all();
+        for (auto& worker : m_Workers)
+            worker.join();
+    }
+
+    template <typename F>
+    std::future<void> Submit(F&& task)
+    {
+        auto packagedTask = std::make_shared<std::packaged_task<void()>>(std::forward<F>(task));
+        std::future<void> future = packagedTask->get_future();
+        {
+            std::lock_guard lock(m_Mutex);
+            m_Tasks.emplace([packagedTask]() { (*packagedTask)(); });
+        }
+        m_Condition.notify_one();
+
+        return future;
+    }
+
+    // Runs function(i) for every i in [0, count) and blocks until all of them finished.
+    // The calling thread works on the range as well, so this is safe to call from inside a worker.
+    // If a call throws, the remaining indices still run and the first exception is rethrown afterwards.
+    void ParallelFor(const size_t count, const std::function<void(size_t)>& function)
+    {
+        if (count == 0)
+            return;
+
+        struct ParallelForState
+        {
+            std::atomic<size_t> nextIndex = 0;
+            std::atomic<size_t> finishedCount = 0;
+            std::function<void(size_t)> function;
+            std::mutex mutex;
+            std::condition_variable condition;
+            // Set once, guarded by mutex
+            std::exception_ptr exception;
+        };
+        auto state = std::make_shared<ParallelForState>();
+        state->function = function;
+
+        auto work = [state, count]() {
+            size_t index;
+            while ((index = state->nextIndex.fetch_add(1)) < count)
+            {
+                try
+                {
+                    state->function(index);
+                }
+                catch (...)
+                {
+                    std::lock_guard lock(state->mutex);
+                    if (!state->exception)
+                        state->exception = std::current_exception();
+                }
+                if (state->finishedCount.fetch_add(1) + 1 == count)
+                {
+                    std::lock_guard lock(state->mutex);
+                    state->condition.notify_all();
+                }
+            }
+        };
+
+        const size_t helperCount = std::min(m_Workers.size(), count - 1);
+        for (size_t i = 0; i < helperCount; i++)
+            Submit(work);
+        work();
+
+        std::unique_lock lock(state->mutex);
+        state->condition.wait(lock, [&state, count]() { return state->finishedCount == count; });
+        if (state->exception)
+            std::rethrow_exception(state->exception);
+    }
+
+    size_t GetWorkerCount() const { return m_Workers.size(); }
+
+private:
+    ThreadPool() : m_Stopping(false)
+    {
+        const uint32_t workerCount = std::max(2u, std::thread::hardware_concurrency()) - 1;
+        for (uint32_t i = 0; i < workerCount; i++)
+            m_Workers.emplace_back([this]() { workerLoop(); });
+    }
+
+    void workerLoop()
+    {
+        while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock lock(m_Mutex);
+                m_Condition.wait(lock, [this]() { return m_Stopping || !m_Tasks.empty(); });
+                if (m_Stopping && m_Tasks.empty())
+                    return;
+                task = std::move(m_Tasks.front());
+                m_Tasks.pop();
+            }
+            task();
+        }
+    }
+
+    std::vector<std::thread> m_Workers;
+    std::queue<std::function<void()>> m_Tasks;
+    std::mutex m_Mutex;
+    std::condition_variable m_Condition;
+    bool m_Stopping;
+};
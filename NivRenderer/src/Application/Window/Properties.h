@@ -92,7 +92,11 @@ bool displayProperty(std::pair<std::string, Property>& property, std::string& na
     case PropertyType::STRING:
         {
             auto* inputString = static_cast<std::string*>(property.second.valuePtr);
-            ImGui::InputText(label, inputString, 0, InputTextCallback, (void*)inputString);
+            if (ImGui::InputText(label, inputString, 0, InputTextCallback, (void*)inputString))
+            {
+                wasEdited = true;
+                property.second.callback();
+            }
             ImGui::Spacing();
             break;
         }
@@ -116,16 +120,17 @@ bool displayProperty(std::pair<std::string, Property>& property, std::string& na
         break;
     case PropertyType::MATERIALDROPDOWN:
     {
-        auto* materialAsset = static_cast<MaterialAsset**>(property.second.valuePtr);
-        if (ImGui::BeginCombo("Material", (*materialAsset)->GetName().c_str()))
+        auto* materialHandle = static_cast<AssetHandle<MaterialAsset>*>(property.second.valuePtr);
+        const MaterialAsset* materialAsset = AssetManager::GetInstance().GetMaterial(*materialHandle);
+        if (ImGui::BeginCombo("Material", materialAsset ? materialAsset->GetName().c_str() : "None"))
         {
             for (const uint32_t materialId : AssetManager::GetInstance().GetMaterialIds(true))
             {
-                const bool isSelected = (*materialAsset)->GetId() == materialId;
+                const bool isSelected = materialAsset && materialAsset->GetId() == materialId;
                 const auto currentMaterial = AssetManager::GetInstance().GetMaterial(materialId);
                 if (ImGui::Selectable(currentMaterial->GetName().c_str(), isSelected))
                 {
-                    *materialAsset = currentMaterial;
+                    *materialHandle = AssetManager::GetInstance().GetMaterialHandle(materialId);
                     wasEdited = true;
                 }
             }
@@ -165,7 +170,7 @@ inline void BuildProperties(const int32_t& selectedSceneObject, Scene* scene)
 				for (auto& it : component->GetComponentProperties())
 				{
                     if (displayProperty(it, componentName))
-						sceneObject->SetDirtyFlag(true);
+						ECSRegistry::GetInstance().MarkChanged(selectedSceneObject, component);
 				}
 			}
 		}
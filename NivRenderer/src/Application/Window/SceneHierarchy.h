@@ -1,6 +1,7 @@
 #pragma once
 #include "imgui.h"
 #include "Application/Util/Instrumentor.h"
+#include "Application/Util/MemoryTracker.h"
 #include "Entity/Assets/AssetManager.h"
 
 inline void displaySceneObjectContextMenu(Scene* scene, const uint32_t sceneObjectId, int32_t& selectedObjectId, const bool allowDelete)
@@ -238,6 +239,36 @@ inline void BuildSceneHierarchy(Scene* scene, int32_t& selectedSceneObjectId)
             {
                 ImGui::Text(std::format("{}: {}microseconds", it.first, std::to_string(it.second)).c_str());
             }
+
+            ImGui::SeparatorText("Memory");
+            for (auto& [category, entries] : MemoryTracker::GetInstance().GetCategories())
+            {
+                const std::string totalSize = MemoryTracker::FormatSize(MemoryTracker::GetInstance().GetTotalSize(category));
+                if (ImGui::TreeNode(std::format("{}: {}", category, totalSize).c_str()))
+                {
+                    for (auto& entry : entries)
+                        ImGui::Text(std::format("{}: {}", entry.second.Name, MemoryTracker::FormatSize(entry.second.Size)).c_str());
+                    ImGui::TreePop();
+                }
+            }
+
+            ImGui::SeparatorText("Imports");
+            const auto& importReports = AssetManager::GetInstance().GetImportReports();
+            for (size_t i = 0; i < importReports.size(); i++)
+            {
+                const ImportReport& report = importReports[i];
+                const std::string label = std::format("{} ({}{})##{}", report.path, ImportSettings::Get(report.profile).name,
+                                                      report.fromCache ? ", cached" : "", i);
+                if (ImGui::TreeNode(label.c_str()))
+                {
+                    ImGui::Text(std::format("Parse: {}microseconds", report.parseTime).c_str());
+                    ImGui::Text(std::format("Post-process: {}microseconds", report.postProcessTime).c_str());
+                    ImGui::Text(std::format("Conversion: {}microseconds", report.conversionTime).c_str());
+                    ImGui::Text(std::format("Optimization: {}microseconds", report.optimizationTime).c_str());
+                    ImGui::Text(std::format("Texture decode: {}microseconds", report.textureDecodeTime).c_str());
+                    ImGui::TreePop();
+                }
+            }
             ImGui::EndTabItem();   
         }
         ImGui::EndTabBar();
@@ -256,7 +256,7 @@ void Window::RenderImGui(Scene* scene)
 			if (ImGuizmo::IsUsing())
 			{
                 m_ArcballMove = false;
-                ECSRegistry::GetInstance().GetEntity<Entity>(m_SelectedObject)->SetDirtyFlag(true);
+                ECSRegistry::GetInstance().MarkChanged<TransformComponent>(m_SelectedObject);
                 glm::vec3 deltaRotation;
                 ImGuizmo::DecomposeMatrixToComponents(glm::value_ptr(modelMatrix), glm::value_ptr(position), glm::value_ptr(deltaRotation), glm::value_ptr(scale));
                 deltaRotation -= rotation;
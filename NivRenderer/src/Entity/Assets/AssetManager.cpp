@@ -1,100 +1,277 @@
 #include "AssetManager.h"
 
+#include <fstream>
 #include <ranges>
 
 #include "IdManager.h"
+#include "GltfImporter.h"
+#include "MeshOptimizer.h"
+#include "Application/Util/FileUtils.h"
+#include "Application/Util/ImageUtils.h"
+#include "Application/Util/Instrumentor.h"
+#include "Application/Util/MemoryTracker.h"
+#include "Application/Util/ThreadPool.h"
 #include "json.hpp"
 #include "stb_image.h"
-#include "stb_image_resize.h"
 
-AssetManager::AssetManager()
+AssetManager::AssetManager() : m_UploadCounter(0)
 {
     m_Importer = CreateScope<Assimp::Importer>();
+    m_ModelCache = CreateScope<ModelCache>("cache/models");
+    m_TextureCache = CreateScope<TextureCache>("cache/textures");
+    m_FileWatcher = CreateScope<FileWatcher>();
     loadDefaultMeshAndTextures();
 }
 
-MeshAsset* AssetManager::LoadMesh(const std::string& path)
+MeshAsset* AssetManager::LoadMesh(const std::string& path, const ImportProfile importProfile)
 {
     if (m_LoadedMeshAssets.contains(path))
     {
         return m_LoadedMeshAssets[path].get();
     }
+    if (m_MeshAliases.contains(path))
+        return m_MeshAliases[path];
 
-    const aiScene* scene = m_Importer->ReadFile(
-        path,
-        aiProcess_FlipUVs | aiProcess_OptimizeMeshes | aiProcess_CalcTangentSpace | aiProcess_GenSmoothNormals |
-            aiProcess_JoinIdenticalVertices | aiProcess_Triangulate | aiProcess_GenUVCoords | aiProcess_SortByPType |
-            aiProcess_RemoveRedundantMaterials | aiProcess_FixInfacingNormals);
-
-    if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode)
-    {
-        SPDLOG_DEBUG(std::string("ERROR::ASSIMP::") + m_Importer->GetErrorString());
+    const Model* model = LoadModel(path, importProfile);
+    if (!model)
         return nullptr;
-    }
-    const SubModel tempSubModel;
-    std::vector tempVector = {tempSubModel};
-    processNode(scene->mRootNode, scene, tempVector, path);
 
-    return tempSubModel.mesh;
+    return findFirstMesh(model->subModels);
 }
 
 MeshAsset* AssetManager::GetMesh(const uint32_t id)
 {
-    for (const auto& meshAsset : m_LoadedMeshAssets | std::views::values)
-    {
-        if (meshAsset->GetId() == id)
-            return meshAsset.get();
-    }
-    return nullptr;
+    return m_MeshRegistry.Get(id);
 }
 
-TextureAsset* AssetManager::LoadTexture(std::string& path, bool flipVertical, bool loadOnlyOneChannel, int channelIndex)
+void AssetManager::LoadMeshDataAsync(const std::vector<MeshAsset*>& meshAssets)
 {
-    if (loadOnlyOneChannel)
+    std::erase_if(m_PendingMeshLoads, [](const auto& pendingLoad) {
+        return pendingLoad.second.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    });
+
+    // The cache entry holds the whole model, so meshes of the same model are restored with a single read
+    std::unordered_map<std::string, std::pair<MeshSource, std::vector<MeshAsset*>>> meshesBySource;
+    for (const auto meshAsset : meshAssets)
     {
-        std::string fileName = path.substr(0, path.find_last_of('.'));
-        const std::string fileEnding = path.substr(path.find_last_of('.'), path.size());
-        fileName += "_@" + std::to_string(channelIndex);
-        path = fileName + fileEnding;
+        if (meshAsset->IsLoading() || !meshAsset->IsDataReleased())
+            continue;
+
+        const auto sourceIt = m_MeshSources.find(meshAsset->GetId());
+        if (sourceIt == m_MeshSources.end())
+            continue;
+        meshAsset->SetLoading(true);
+        auto& [source, meshes] = meshesBySource[sourceIt->second.modelPath];
+        source = sourceIt->second;
+        meshes.push_back(meshAsset);
     }
 
-    const bool textureExists = m_LoadedTextureAssets.contains(path);
-    if (textureExists && m_LoadedTextureAssets[path]->GetFlipVertical() == flipVertical)
-        return m_LoadedTextureAssets[path].get();
+    for (auto& [source, meshes] : meshesBySource | std::views::values)
+    {
+        const std::shared_future<void> pendingLoad =
+            ThreadPool::GetInstance()
+                .Submit([this, source, meshes]() {
+                    restoreMeshData(source, meshes);
+                    for (const auto meshAsset : meshes)
+                        meshAsset->SetLoading(false);
+                })
+                .share();
+        for (const auto meshAsset : meshes)
+            m_PendingMeshLoads[meshAsset->GetId()] = pendingLoad;
+    }
+}
 
-    std::string pathToUse = path;
-    if (path.find_last_of('@') != std::string::npos)
+bool AssetManager::RequireMeshData(MeshAsset* meshAsset)
+{
+    waitForMeshLoad(meshAsset->GetId());
+    if (meshAsset->IsDataReleased())
     {
-        loadOnlyOneChannel = true;
-        channelIndex = std::stoi(path.substr(path.find_last_of('@') + 1, path.size()));
-        pathToUse = path.substr(0, path.find_last_of('@') - 1) + path.substr(path.find_last_of('@') + 2, path.size());
+        LoadMeshDataAsync({meshAsset});
+        waitForMeshLoad(meshAsset->GetId());
     }
 
-    m_LoadedTextureAssets[path] = CreateScope<TextureAsset>(IdManager::GetInstance().CreateNewId(), pathToUse,
-                                                               flipVertical, loadOnlyOneChannel, channelIndex);
-    const auto textureAsset = m_LoadedTextureAssets[path].get();
+    return !meshAsset->IsDataReleased();
+}
 
-    stbi_set_flip_vertically_on_load(textureAsset->GetFlipVertical());
+TextureAsset* AssetManager::LoadTexture(std::string& path, bool flipVertical, bool loadOnlyOneChannel, int channelIndex,
+                                        MaterialTextureSlot slot)
+{
+    bool needsImport;
+    TextureAsset* textureAsset = registerTexture(path, flipVertical, loadOnlyOneChannel, channelIndex, slot, needsImport);
+    if (needsImport)
+        importTexture(textureAsset);
 
-    importTexture(textureAsset);
+    return textureAsset;
+}
+
+TextureAsset* AssetManager::LoadTextureAsync(std::string& path, bool flipVertical, bool loadOnlyOneChannel, int channelIndex,
+                                             MaterialTextureSlot slot)
+{
+    bool needsImport;
+    TextureAsset* textureAsset = registerTexture(path, flipVertical, loadOnlyOneChannel, channelIndex, slot, needsImport);
+    if (needsImport)
+        importTextureAsync(textureAsset);
 
     return textureAsset;
 }
 
 void AssetManager::ReloadTexture(TextureAsset* textureAsset)
 {
+    waitForTextureImport(textureAsset->GetId());
     importTexture(textureAsset);
 }
 
-TextureAsset* AssetManager::GetTexture(const uint32_t id)
+void AssetManager::ReloadTextureAsync(TextureAsset* textureAsset)
+{
+    importTextureAsync(textureAsset);
+}
+
+void AssetManager::LoadTexturesAsync(const std::vector<TextureAsset*>& textureAssets)
+{
+    if (!textureAssets.empty())
+        importTexturesAsync(textureAssets);
+}
+
+EnvironmentMap* AssetManager::LoadEnvironmentMapAsync(const std::string& path)
+{
+    auto& environmentMap = m_LoadedEnvironmentMaps[path];
+    if (!environmentMap)
+    {
+        environmentMap = CreateScope<EnvironmentMap>(IdManager::GetInstance().CreateNewId(), path);
+        m_FileWatcher->Watch(path);
+    }
+    if (!environmentMap->IsLoading() && !environmentMap->HasData())
+        importEnvironmentMapAsync(environmentMap.get());
+
+    return environmentMap.get();
+}
+
+void AssetManager::SetTextureSizePolicy(const TextureSizePolicy& sizePolicy)
+{
+    m_TextureSizePolicy = sizePolicy;
+}
+
+void AssetManager::SetResidencyPolicy(const ResidencyPolicy& residencyPolicy)
+{
+    m_ResidencyPolicy = residencyPolicy;
+}
+
+void AssetManager::OnMeshUploaded(MeshAsset* meshAsset)
+{
+    // Without a cache entry the data couldn't be restored, e.g. for saving the scene
+    if (!m_MeshSources.contains(meshAsset->GetId()))
+        return;
+
+    m_UploadedMeshes[meshAsset->GetId()] = ++m_UploadCounter;
+    if (m_ResidencyPolicy.GetMeshResidency() == AssetResidency::EVICT_AFTER_UPLOAD)
+        releaseMeshData(meshAsset);
+}
+
+void AssetManager::OnTextureUploaded(TextureAsset* textureAsset)
 {
+    m_UploadedTextures[textureAsset->GetId()] = ++m_UploadCounter;
+    if (m_ResidencyPolicy.GetTextureResidency() == AssetResidency::EVICT_AFTER_UPLOAD)
+        textureAsset->UnloadData();
+}
+
+void AssetManager::OnEnvironmentMapUploaded(EnvironmentMap* environmentMap)
+{
+    // Reading the converted faces back from the cache is cheap, so only KEEP holds on to them
+    if (m_ResidencyPolicy.GetTextureResidency() != AssetResidency::KEEP)
+        environmentMap->UnloadData();
+}
+
+void AssetManager::UpdateResidency()
+{
+    std::erase_if(m_PendingMeshLoads, [](const auto& pendingLoad) {
+        return pendingLoad.second.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    });
+
+    // Data of uploaded assets that was restored (e.g. for saving) or kept under an earlier policy
+    struct ReleaseCandidate
+    {
+        uint64_t uploadCounter;
+        MeshAsset* meshAsset;
+        TextureAsset* textureAsset;
+        size_t dataSize;
+    };
+    std::vector<ReleaseCandidate> candidates;
+    auto collectCandidates = [&candidates](auto& uploadedAssets, auto& registry, const AssetResidency residency,
+                                           auto makeCandidate) {
+        for (auto it = uploadedAssets.begin(); it != uploadedAssets.end();)
+        {
+            const auto asset = registry.Get(it->first);
+            if (!asset)
+            {
+                it = uploadedAssets.erase(it);
+                continue;
+            }
+            if (residency != AssetResidency::KEEP && !asset->IsLoading() && asset->GetDataSize())
+                candidates.push_back(makeCandidate(it->second, asset));
+            ++it;
+        }
+    };
+    collectCandidates(m_UploadedMeshes, m_MeshRegistry, m_ResidencyPolicy.GetMeshResidency(),
+                      [](const uint64_t uploadCounter, MeshAsset* meshAsset) {
+                          return ReleaseCandidate{uploadCounter, meshAsset, nullptr, meshAsset->GetDataSize()};
+                      });
+    collectCandidates(m_UploadedTextures, m_TextureRegistry, m_ResidencyPolicy.GetTextureResidency(),
+                      [](const uint64_t uploadCounter, TextureAsset* textureAsset) {
+                          return ReleaseCandidate{uploadCounter, nullptr, textureAsset, textureAsset->GetDataSize()};
+                      });
+
+    size_t totalDataSize = 0;
+    for (const auto& meshAsset : m_LoadedMeshAssets | std::views::values)
+    {
+        if (!meshAsset->IsLoading())
+            totalDataSize += meshAsset->GetDataSize();
+    }
     for (const auto& textureAsset : m_LoadedTextureAssets | std::views::values)
     {
-        if (textureAsset->GetId() == id)
-            return textureAsset.get();
+        if (!textureAsset->IsLoading())
+            totalDataSize += textureAsset->GetDataSize();
     }
 
-    return nullptr;
+    std::ranges::sort(candidates, {}, &ReleaseCandidate::uploadCounter);
+    for (const auto& candidate : candidates)
+    {
+        const AssetResidency residency = candidate.meshAsset ? m_ResidencyPolicy.GetMeshResidency()
+                                                             : m_ResidencyPolicy.GetTextureResidency();
+        if (residency == AssetResidency::EVICT_UNDER_PRESSURE && totalDataSize <= m_ResidencyPolicy.GetCpuMemoryBudget())
+            continue;
+
+        totalDataSize -= candidate.dataSize;
+        if (candidate.meshAsset)
+            releaseMeshData(candidate.meshAsset);
+        else
+            candidate.textureAsset->UnloadData();
+    }
+
+    for (const auto& meshAsset : m_LoadedMeshAssets | std::views::values)
+    {
+        if (!meshAsset->IsLoading())
+            reportDataSize("Mesh Data", meshAsset->GetId(), meshAsset->GetPath(), meshAsset->GetDataSize());
+    }
+    for (const auto& textureAsset : m_LoadedTextureAssets | std::views::values)
+    {
+        if (!textureAsset->IsLoading())
+            reportDataSize("Texture Data", textureAsset->GetId(), textureAsset->GetPath(), textureAsset->GetDataSize());
+    }
+    // Replaced assets (e.g. when a scene gets loaded) are not in the maps anymore
+    std::erase_if(m_ReportedDataSizes, [this](const auto& reportedDataSize) {
+        const uint32_t id = reportedDataSize.first;
+        if (m_MeshRegistry.Get(id) || m_TextureRegistry.Get(id))
+            return false;
+
+        MemoryTracker::GetInstance().Untrack("Mesh Data", id);
+        MemoryTracker::GetInstance().Untrack("Texture Data", id);
+        return true;
+    });
+}
+
+TextureAsset* AssetManager::GetTexture(const uint32_t id)
+{
+    return m_TextureRegistry.Get(id);
 }
 
 Shader* AssetManager::LoadShader(const std::string& path, ShaderType shaderType)
@@ -105,32 +282,203 @@ Shader* AssetManager::LoadShader(const std::string& path, ShaderType shaderType)
     }
 
     m_LoadedShaders[path] = CreateScope<Shader>(path.c_str(), shaderType);
+    m_FileWatcher->Watch(path);
+    watchShaderIncludes(path, path);
     return m_LoadedShaders[path].get();
 }
 
-Model* AssetManager::LoadModel(const std::string& path)
+Model* AssetManager::LoadModel(const std::string& path, const ImportProfile importProfile)
 {
     if (m_LoadedModels.contains(path))
     {
+        if (m_LoadedModels[path]->importProfile != importProfile)
+            reloadModel(path, importProfile);
         return m_LoadedModels[path].get();
     }
 
-    const aiScene* scene = m_Importer->ReadFile(
-        path,
-        aiProcess_FlipUVs | aiProcess_OptimizeMeshes | aiProcess_CalcTangentSpace | aiProcess_GenSmoothNormals |
-            aiProcess_JoinIdenticalVertices | aiProcess_Triangulate | aiProcess_GenUVCoords | aiProcess_SortByPType |
-            aiProcess_RemoveRedundantMaterials | aiProcess_FixInfacingNormals);
+    PROFILE_SCOPE("AssetManager::LoadModel")
+    m_FileWatcher->Watch(path);
+
+    const ImportSettings& settings = ImportSettings::Get(importProfile);
+    ImportReport report(path, importProfile);
+    auto phaseStart = std::chrono::steady_clock::now();
+    CachedModel cachedModel;
+    if (m_ModelCache->Read(path, importProfile, cachedModel))
+    {
+        report.fromCache = true;
+        report.parseTime = ImportReport::GetElapsedTime(phaseStart);
+        phaseStart = std::chrono::steady_clock::now();
+        Model* model = createModel(path, importProfile, cachedModel);
+        registerMeshSources(model->subModels, {path, importProfile});
+        report.conversionTime = ImportReport::GetElapsedTime(phaseStart);
+        addImportReport(std::move(report), model);
+        return model;
+    }
+
+    // glTF is read directly from the mapped buffers, Assimp is only needed for the other formats
+    if (GltfImporter::CanImport(path))
+    {
+        GltfImporter gltfImporter;
+        if (gltfImporter.Import(path, importProfile, cachedModel, report))
+        {
+            phaseStart = std::chrono::steady_clock::now();
+            Model* model = createModel(path, importProfile, cachedModel);
+            report.conversionTime += ImportReport::GetElapsedTime(phaseStart);
+            cacheModel(path, importProfile, *model);
+            addImportReport(std::move(report), model);
+            return model;
+        }
+        SPDLOG_DEBUG("Falling back to Assimp for " + path);
+        report = ImportReport(path, importProfile);
+    }
+
+    // Post-processing is applied separately so that the report can tell it apart from parsing
+    phaseStart = std::chrono::steady_clock::now();
+    const aiScene* scene = m_Importer->ReadFile(path, 0);
     if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode)
     {
         SPDLOG_DEBUG(std::string("ERROR::ASSIMP::") + m_Importer->GetErrorString());
 
         return nullptr;
     }
+    report.parseTime = ImportReport::GetElapsedTime(phaseStart);
+    phaseStart = std::chrono::steady_clock::now();
+    scene = m_Importer->ApplyPostProcessing(settings.postProcessFlags);
+    if (!scene)
+    {
+        SPDLOG_DEBUG(std::string("ERROR::ASSIMP::") + m_Importer->GetErrorString());
+
+        return nullptr;
+    }
+    report.postProcessTime = ImportReport::GetElapsedTime(phaseStart);
+
+    // Build the SubModel tree and create the (still empty) assets serially, since ids and names have to be unique
+    phaseStart = std::chrono::steady_clock::now();
+    ModelImportContext context;
+    context.path = path;
+    context.meshes.resize(scene->mNumMeshes, nullptr);
+    context.materials.resize(scene->mNumMaterials, nullptr);
+    auto model = CreateScope<Model>();
+    processNode(scene->mRootNode, scene, model->subModels, context);
+    model->name = std::filesystem::path(path).stem().string();
+    model->importProfile = importProfile;
+
+    // Mesh conversion and material resolution only touch their own asset, so they can run on all cores
+    ThreadPool& threadPool = ThreadPool::GetInstance();
+    threadPool.ParallelFor(context.newMeshes.size(), [&context, &settings, scene](const size_t i) {
+        const auto& [meshIndex, meshAsset] = context.newMeshes[i];
+        const aiMesh* aiMesh = scene->mMeshes[meshIndex];
+        processMesh(aiMesh, meshAsset.get(),
+                    settings.tangentsForAllMeshes || hasNormalTexture(scene->mMaterials[aiMesh->mMaterialIndex]));
+    });
+    const std::string directory = path.substr(0, path.find_last_of('/'));
+    threadPool.ParallelFor(context.newMaterials.size(), [&context, &directory, scene](const size_t i) {
+        const auto& [materialIndex, materialAsset] = context.newMaterials[i];
+        processMaterial(scene->mMaterials[materialIndex], directory, materialAsset.get());
+    });
+    m_Importer->FreeScene();
+    report.conversionTime = ImportReport::GetElapsedTime(phaseStart);
+
+    phaseStart = std::chrono::steady_clock::now();
+    std::vector<uint64_t> meshHashes(context.newMeshes.size());
+    threadPool.ParallelFor(context.newMeshes.size(), [&context, &meshHashes, &settings](const size_t i) {
+        MeshAsset* meshAsset = context.newMeshes[i].second.get();
+        if (settings.optimizeMeshes)
+            MeshOptimizer::OptimizeMesh(meshAsset->GetPath(), meshAsset->GetVertices(), meshAsset->GetIndices());
+        if (settings.generateLods)
+            MeshOptimizer::GenerateLods(meshAsset->GetPath(), meshAsset->GetVertices(), meshAsset->GetIndices(),
+                                        meshAsset->GetLods());
+        MeshOptimizer::BuildMeshlets(meshAsset->GetVertices(), meshAsset->GetIndices(), meshAsset->GetMeshlets());
+        meshHashes[i] = hashMeshContent(meshAsset->GetVertices(), meshAsset->GetIndices());
+    });
+    report.optimizationTime = ImportReport::GetElapsedTime(phaseStart);
+
+    // Meshes that already exist (e.g. the same prop exported into several model files) are swapped for the existing one
+    std::unordered_map<uint32_t, MeshAsset*> duplicateMeshes;
+    for (size_t i = 0; i < context.newMeshes.size(); i++)
+    {
+        auto& meshAsset = context.newMeshes[i].second;
+        MeshAsset* newMeshAsset = meshAsset.get();
+        const uint32_t newMeshId = newMeshAsset->GetId();
+        if (MeshAsset* registeredMesh = registerMesh(meshAsset, meshHashes[i]);
+            registeredMesh != newMeshAsset)
+            duplicateMeshes[newMeshId] = registeredMesh;
+    }
+    if (!duplicateMeshes.empty())
+        remapMeshes(model->subModels, duplicateMeshes);
+
+    std::vector<MaterialAsset*> newMaterials;
+    for (auto& materialAsset : context.newMaterials | std::views::values)
+        newMaterials.push_back(materialAsset.get());
+    prefetchTextureHashes(newMaterials);
+    for (auto& materialAsset : context.newMaterials | std::views::values)
+    {
+        registerMaterialTextures(materialAsset.get());
+        storeMaterial(std::move(materialAsset));
+    }
+
+    m_LoadedModels[path] = std::move(model);
+    cacheModel(path, importProfile, *m_LoadedModels[path]);
+    addImportReport(std::move(report), m_LoadedModels[path].get());
+
+    return m_LoadedModels[path].get();
+}
+
+Model* AssetManager::createModel(const std::string& path, const ImportProfile importProfile, CachedModel& cachedModel)
+{
+    std::vector<uint64_t> meshHashes(cachedModel.meshes.size());
+    ThreadPool::GetInstance().ParallelFor(cachedModel.meshes.size(), [&cachedModel, &meshHashes](const size_t i) {
+        meshHashes[i] = hashMeshContent(cachedModel.meshes[i].vertices, cachedModel.meshes[i].indices);
+    });
+
+    std::vector<MeshAsset*> meshes;
+    meshes.reserve(cachedModel.meshes.size());
+    for (size_t i = 0; i < cachedModel.meshes.size(); i++)
+    {
+        CachedMesh& cachedMesh = cachedModel.meshes[i];
+        if (m_LoadedMeshAssets.contains(cachedMesh.path))
+            meshes.push_back(m_LoadedMeshAssets[cachedMesh.path].get());
+        else if (m_MeshAliases.contains(cachedMesh.path))
+            meshes.push_back(m_MeshAliases[cachedMesh.path]);
+        else
+        {
+            auto meshAsset = CreateScope<MeshAsset>(IdManager::GetInstance().CreateNewId(), cachedMesh.path,
+                                                    std::move(cachedMesh.vertices), std::move(cachedMesh.indices));
+            meshAsset->GetLods() = std::move(cachedMesh.lods);
+            meshAsset->GetMeshlets() = std::move(cachedMesh.meshlets);
+            meshes.push_back(registerMesh(meshAsset, meshHashes[i]));
+        }
+    }
+
+    std::vector<MaterialAsset*> materials;
+    std::vector<MaterialAsset*> newMaterials;
+    materials.reserve(cachedModel.materials.size());
+    for (auto& cachedMaterial : cachedModel.materials)
+    {
+        MaterialAsset* materialAsset = GetMaterial(cachedMaterial.name);
+        if (!materialAsset)
+        {
+            const uint32_t materialAssetId = IdManager::GetInstance().CreateNewId();
+            materialAsset = storeMaterial(CreateScope<MaterialAsset>(materialAssetId, cachedMaterial.name));
+            materialAsset->GetDiffusePath() = cachedMaterial.diffusePath;
+            materialAsset->GetNormalPath() = cachedMaterial.normalPath;
+            materialAsset->GetMetallicPath() = cachedMaterial.metallicPath;
+            materialAsset->GetRoughnessPath() = cachedMaterial.roughnessPath;
+            materialAsset->GetAOPath() = cachedMaterial.aoPath;
+            materialAsset->GetEmissivePath() = cachedMaterial.emissivePath;
+            newMaterials.push_back(materialAsset);
+        }
+        materials.push_back(materialAsset);
+    }
+    prefetchTextureHashes(newMaterials);
+    for (const auto materialAsset : newMaterials)
+        registerMaterialTextures(materialAsset);
 
     m_LoadedModels[path] = CreateScope<Model>();
     Model* model = m_LoadedModels[path].get();
-    processNode(scene->mRootNode, scene, model->subModels, path);
-    model->name = path.substr(path.find_last_of('/')+1, path.find_last_of('.'));
+    model->name = cachedModel.name;
+    model->importProfile = importProfile;
+    processCachedNodes(cachedModel.nodes, model->subModels, meshes, materials);
 
     return model;
 }
@@ -145,28 +493,21 @@ Model* AssetManager::GetModel(const std::string& path)
 
 MaterialAsset* AssetManager::GetMaterial(const std::string& name)
 {
-    for (const auto& asset : m_LoadedMaterialAssets | std::views::values)
-    {
-        if (asset->GetName() == name)
-            return asset.get();
-    }
+    if (const auto it = m_MaterialIdsByName.find(name); it != m_MaterialIdsByName.end())
+        return m_MaterialRegistry.Get(it->second.front());
 
     return nullptr;
 }
 
 MaterialAsset* AssetManager::GetMaterial(uint32_t id)
 {
-    if (m_LoadedMaterialAssets.contains(id))
-        return m_LoadedMaterialAssets[id].get();
-
-    return nullptr;
+    return m_MaterialRegistry.Get(id);
 }
 
 MaterialAsset* AssetManager::CreateMaterial()
 {
     const uint32_t id = IdManager::GetInstance().CreateNewId();
-    m_LoadedMaterialAssets[id] = CreateScope<MaterialAsset>(id, "New Material");
-    const auto newMaterial = m_LoadedMaterialAssets[id].get();
+    const auto newMaterial = storeMaterial(CreateScope<MaterialAsset>(id, "New Material"));
     newMaterial->GetDiffusePath() = "default";
     *newMaterial->GetDiffuseTextureAsset() = m_LoadedTextureAssets["default"].get();
 
@@ -175,7 +516,25 @@ MaterialAsset* AssetManager::CreateMaterial()
 
 void AssetManager::RemoveMaterial(uint32_t id)
 {
-    m_LoadedMaterialAssets.erase(id);
+    const auto it = m_LoadedMaterialAssets.find(id);
+    if (it == m_LoadedMaterialAssets.end())
+        return;
+
+    releaseMaterialName(id);
+    m_MaterialRegistry.Remove(id);
+    m_LoadedMaterialAssets.erase(it);
+}
+
+void AssetManager::UpdateMaterialName(const uint32_t id)
+{
+    const MaterialAsset* materialAsset = m_MaterialRegistry.Get(id);
+    if (!materialAsset)
+        return;
+    if (const auto it = m_MaterialNames.find(id); it != m_MaterialNames.end() && it->second == materialAsset->GetName())
+        return;
+
+    releaseMaterialName(id);
+    indexMaterialName(id, materialAsset->GetName());
 }
 
 std::vector<uint32_t> AssetManager::GetMaterialIds(bool includeDefault) const
@@ -251,65 +610,304 @@ std::vector<std::pair<std::string, TextureAsset*>> AssetManager::GetTextures() c
 
 void AssetManager::AddTexture(const std::string& path, Scope<TextureAsset>&& textureAsset)
 {
-    m_LoadedTextureAssets[path] = std::move(textureAsset);
+    const uint64_t contentHash =
+        hashTextureContent(textureAsset->GetPath(), textureAsset->GetFlipVertical(), textureAsset->GetLoadOnlyOneChannel(),
+                           *textureAsset->GetChannelIndex(), textureAsset->GetSlot());
+    if (contentHash)
+        m_TexturesByContentHash.try_emplace(contentHash, textureAsset.get());
+    storeTexture(path, std::move(textureAsset));
 }
 
 void AssetManager::AddMesh(const std::string& path, Scope<MeshAsset>&& meshAsset)
 {
-    m_LoadedMeshAssets[path] = std::move(meshAsset);
+    m_MeshesByContentHash.try_emplace(hashMeshContent(meshAsset->GetVertices(), meshAsset->GetIndices()), meshAsset.get());
+    storeMesh(path, std::move(meshAsset));
 }
 
 void AssetManager::AddMaterial(Scope<MaterialAsset>&& materialAsset)
 {
-    m_LoadedMaterialAssets[materialAsset->GetId()] = std::move(materialAsset);
+    storeMaterial(std::move(materialAsset));
 }
 
 void AssetManager::AddModel(const std::string& path, Scope<Model>&& model)
 {
+    m_FileWatcher->Watch(path);
     m_LoadedModels[path] = std::move(model);
 }
 
+AssetChanges AssetManager::ProcessFileChanges()
+{
+    AssetChanges assetChanges;
+    for (const auto& path : m_FileWatcher->PollChanges())
+    {
+        if (m_LoadedShaders.contains(path) || m_ShaderIncludes.contains(path))
+            reloadShaders(path);
+        if (m_LoadedModels.contains(path))
+            reloadModel(path, m_LoadedModels[path]->importProfile);
+        if (const auto it = m_LoadedEnvironmentMaps.find(path); it != m_LoadedEnvironmentMaps.end())
+        {
+            importEnvironmentMapAsync(it->second.get());
+            assetChanges.environmentMaps.push_back(it->second.get());
+        }
+        for (const auto& textureAsset : m_LoadedTextureAssets | std::views::values)
+        {
+            if (textureAsset->GetPath() == path)
+                assetChanges.textures.push_back(textureAsset.get());
+        }
+    }
+    assetChanges.meshes = std::move(m_ChangedMeshes);
+    m_ChangedMeshes.clear();
+
+    return assetChanges;
+}
+
+const std::vector<ImportReport>& AssetManager::GetImportReports()
+{
+    for (auto& report : m_ImportReports)
+    {
+        report.textureDecodeTime = 0;
+        for (const uint32_t textureId : report.textureIds)
+        {
+            const TextureAsset* textureAsset = m_TextureRegistry.Get(textureId);
+            if (textureAsset && !textureAsset->IsLoading())
+                report.textureDecodeTime += textureAsset->GetLoadTime();
+        }
+    }
+
+    return m_ImportReports;
+}
+
+TextureAsset* AssetManager::registerTexture(std::string& path, bool flipVertical, bool loadOnlyOneChannel,
+                                           int channelIndex, MaterialTextureSlot slot, bool& needsImport)
+{
+    needsImport = false;
+    if (loadOnlyOneChannel)
+    {
+        std::string fileName = path.substr(0, path.find_last_of('.'));
+        const std::string fileEnding = path.substr(path.find_last_of('.'), path.size());
+        fileName += "_@" + std::to_string(channelIndex);
+        path = fileName + fileEnding;
+    }
+
+    const bool textureExists = m_LoadedTextureAssets.contains(path);
+    if (textureExists && m_LoadedTextureAssets[path]->GetFlipVertical() == flipVertical)
+        return m_LoadedTextureAssets[path].get();
+    if (textureExists)
+    {
+        // The texture gets replaced, so nothing may point to the old one anymore
+        const TextureAsset* oldTextureAsset = m_LoadedTextureAssets[path].get();
+        waitForTextureImport(oldTextureAsset->GetId());
+        std::erase_if(m_TexturesByContentHash, [oldTextureAsset](const auto& entry) { return entry.second == oldTextureAsset; });
+        std::erase_if(m_TextureAliases, [oldTextureAsset](const auto& entry) { return entry.second == oldTextureAsset; });
+    }
+    if (const auto it = m_TextureAliases.find(path); it != m_TextureAliases.end())
+    {
+        if (it->second->GetFlipVertical() == flipVertical)
+            return it->second;
+        m_TextureAliases.erase(it);
+    }
+
+    std::string pathToUse = path;
+    if (path.find_last_of('@') != std::string::npos)
+    {
+        loadOnlyOneChannel = true;
+        channelIndex = std::stoi(path.substr(path.find_last_of('@') + 1, path.size()));
+        pathToUse = path.substr(0, path.find_last_of('@') - 1) + path.substr(path.find_last_of('@') + 2, path.size());
+    }
+
+    // Identical images behind different paths share one asset (and with that one decode and one GPU texture)
+    const uint64_t contentHash = hashTextureContent(pathToUse, flipVertical, loadOnlyOneChannel, channelIndex, slot);
+    if (contentHash && m_TexturesByContentHash.contains(contentHash))
+    {
+        m_TextureAliases[path] = m_TexturesByContentHash[contentHash];
+        return m_TextureAliases[path];
+    }
+
+    TextureAsset* textureAsset = storeTexture(path, CreateScope<TextureAsset>(IdManager::GetInstance().CreateNewId(),
+                                                                             pathToUse, flipVertical, loadOnlyOneChannel,
+                                                                             channelIndex, slot));
+    if (contentHash)
+        m_TexturesByContentHash[contentHash] = textureAsset;
+    needsImport = true;
+
+    return textureAsset;
+}
+
+uint64_t AssetManager::hashTextureContent(const std::string& path, const bool flipVertical, const bool loadOnlyOneChannel,
+                                          const int channelIndex, const MaterialTextureSlot slot)
+{
+    uint64_t fileHash;
+    if (!getFileHash(path, fileHash))
+        return 0;
+
+    // The same file imported with different settings ends up as different texture data
+    const int32_t importSettings[] = {flipVertical, loadOnlyOneChannel, channelIndex, static_cast<int32_t>(slot)};
+    return FileUtils::HashFnv1a(importSettings, sizeof(importSettings), fileHash);
+}
+
+bool AssetManager::getFileHash(const std::string& path, uint64_t& hash)
+{
+    const int64_t lastWriteTime = FileUtils::GetLastWriteTime(path);
+    if (lastWriteTime == 0)
+        return false;
+
+    if (const auto it = m_FileHashes.find(path); it != m_FileHashes.end() && it->second.lastWriteTime == lastWriteTime)
+    {
+        hash = it->second.hash;
+        return true;
+    }
+
+    if (!FileUtils::HashFile(path, hash))
+        return false;
+    m_FileHashes[path] = {lastWriteTime, hash};
+
+    return true;
+}
+
+void AssetManager::prefetchTextureHashes(const std::vector<MaterialAsset*>& materialAssets)
+{
+    std::unordered_set<std::string> uniquePaths;
+    for (const auto materialAsset : materialAssets)
+    {
+        for (const std::string* path : {&materialAsset->GetDiffusePath(), &materialAsset->GetNormalPath(),
+                                        &materialAsset->GetMetallicPath(), &materialAsset->GetRoughnessPath(),
+                                        &materialAsset->GetAOPath(), &materialAsset->GetEmissivePath()})
+        {
+            if (!path->empty() && !m_FileHashes.contains(*path))
+                uniquePaths.insert(*path);
+        }
+    }
+    if (uniquePaths.empty())
+        return;
+
+    // Reading the files is the expensive part, so it is spread over the worker threads
+    const std::vector<std::string> paths(uniquePaths.begin(), uniquePaths.end());
+    std::vector<FileHash> fileHashes(paths.size(), {0, 0});
+    ThreadPool::GetInstance().ParallelFor(paths.size(), [&paths, &fileHashes](const size_t i) {
+        const int64_t lastWriteTime = FileUtils::GetLastWriteTime(paths[i]);
+        if (lastWriteTime != 0 && FileUtils::HashFile(paths[i], fileHashes[i].hash))
+            fileHashes[i].lastWriteTime = lastWriteTime;
+    });
+    for (size_t i = 0; i < paths.size(); i++)
+    {
+        if (fileHashes[i].lastWriteTime != 0)
+            m_FileHashes[paths[i]] = fileHashes[i];
+    }
+}
+
 void AssetManager::importTexture(TextureAsset* textureAsset)
 {
-    const std::string pathToUse = textureAsset->GetPath();
-    unsigned char* loadedData = stbi_load(pathToUse.c_str(), textureAsset->GetWidth(), textureAsset->GetHeight(),
-                                          textureAsset->GetNrComponents(), 0);
+    const auto importStart = std::chrono::steady_clock::now();
+    importTextures({textureAsset}, m_TextureSizePolicy);
+    textureAsset->SetLoadTime(ImportReport::GetElapsedTime(importStart));
+}
+
+void AssetManager::importTextures(const std::vector<TextureAsset*>& textureAssets, const TextureSizePolicy& sizePolicy)
+{
+    std::vector<TextureAsset*> texturesToDecode;
+    for (const auto textureAsset : textureAssets)
+    {
+        if (!m_TextureCache->Read(textureAsset, sizePolicy))
+            texturesToDecode.push_back(textureAsset);
+    }
+    if (texturesToDecode.empty())
+        return;
+
+    // All textures share the same source file, so it only gets decoded once.
+    // Textures are decoded on worker threads, so the flip setting has to be thread local
+    const std::string pathToUse = texturesToDecode[0]->GetPath();
+    stbi_set_flip_vertically_on_load_thread(texturesToDecode[0]->GetFlipVertical());
+
+    int32_t width, height, nrComponents;
+    unsigned char* loadedData = stbi_load(pathToUse.c_str(), &width, &height, &nrComponents, 0);
+    if (!loadedData)
+    {
+        SPDLOG_DEBUG("Could not load texture " + pathToUse + ": " + stbi_failure_reason());
+        return;
+    }
+    PixelBuffer imageData = PixelBuffer::Adopt(loadedData, static_cast<size_t>(width) * height * nrComponents, stbi_image_free);
 
-    unsigned char* resizedData = nullptr;
-    if (*textureAsset->GetWidth() > 4000 && *textureAsset->GetHeight() > 4000)
+    // Slots can have different size caps, so group the textures by the size they end up with
+    std::map<std::pair<int32_t, int32_t>, std::vector<TextureAsset*>> texturesBySize;
+    for (const auto textureAsset : texturesToDecode)
     {
-        resizedData = new unsigned char[1920 * 1080 * *textureAsset->GetNrComponents()];
-        stbir_resize_uint8(loadedData, *textureAsset->GetWidth(), *textureAsset->GetHeight(), 0, resizedData,
-                                   1920, 1080, 0, *textureAsset->GetNrComponents());
-        *textureAsset->GetWidth() = 1920;
-        *textureAsset->GetHeight() = 1080;
-        stbi_image_free(loadedData);
+        const glm::ivec2 targetSize = sizePolicy.GetTargetSize(width, height, textureAsset->GetSlot());
+        texturesBySize[{targetSize.x, targetSize.y}].push_back(textureAsset);
     }
 
-    if (textureAsset->GetLoadOnlyOneChannel())
+    TextureAsset* fullSizeTexture = nullptr;
+    for (const auto& [targetSize, textures] : texturesBySize)
     {
-        const size_t dataSize = (*textureAsset->GetWidth()) * (*textureAsset->GetHeight());
-        auto* data = new unsigned char[dataSize];
+        const auto [targetWidth, targetHeight] = targetSize;
+        PixelBuffer scaledData;
+        if (targetWidth != width || targetHeight != height)
+        {
+            scaledData = PixelBuffer::Allocate(static_cast<size_t>(targetWidth) * targetHeight * nrComponents);
+            ImageUtils::Downscale(imageData.GetData(), width, height, nrComponents, scaledData.GetData(), targetWidth,
+                                  targetHeight);
+        }
+        const unsigned char* data = scaledData.IsEmpty() ? imageData.GetData() : scaledData.GetData();
 
-        for (int32_t y = 0; y < *textureAsset->GetHeight(); y++)
+        std::vector<TextureAsset*> channelTextures;
+        TextureAsset* fullTexture = nullptr;
+        for (const auto textureAsset : textures)
         {
-            for (int32_t x = 0; x < *textureAsset->GetWidth(); x++)
-            {
-                const unsigned char* pixelOffset =
-                    *textureAsset->GetNrComponents() * (y * *textureAsset->GetWidth() + x) + (resizedData ? resizedData : loadedData);
-                data[y * (*textureAsset->GetWidth()) + x] = pixelOffset[*textureAsset->GetChannelIndex()];
-            }
+            *textureAsset->GetWidth() = targetWidth;
+            *textureAsset->GetHeight() = targetHeight;
+            if (textureAsset->GetLoadOnlyOneChannel())
+                channelTextures.push_back(textureAsset);
+            else
+                fullTexture = textureAsset;
         }
-        *textureAsset->GetNrComponents() = 1;
-        textureAsset->SetTextureData(data);
+        if (!channelTextures.empty())
+            extractChannels(data, targetWidth, targetHeight, nrComponents, channelTextures);
 
-        stbi_image_free(resizedData ? resizedData : loadedData);
-        delete[] data;
+        if (fullTexture)
+        {
+            *fullTexture->GetNrComponents() = nrComponents;
+            if (!scaledData.IsEmpty())
+                fullTexture->SetTextureData(std::move(scaledData));
+            else
+                fullSizeTexture = fullTexture;
+        }
     }
-    else
+    // The decoded image is handed over as is once nothing else reads from it, it gets freed after the GPU upload
+    if (fullSizeTexture)
+        fullSizeTexture->SetTextureData(std::move(imageData));
+
+    for (const auto textureAsset : texturesToDecode)
+    {
+        TextureCache::Bake(textureAsset);
+        m_TextureCache->Write(textureAsset, sizePolicy);
+    }
+}
+
+void AssetManager::extractChannels(const unsigned char* pixels, const int32_t width, const int32_t height,
+                                   const int32_t nrComponents, const std::vector<TextureAsset*>& textureAssets)
+{
+    const size_t pixelCount = static_cast<size_t>(width) * height;
+    std::vector<int32_t> channelIndices;
+    std::vector<PixelBuffer> channels;
+    std::vector<unsigned char*> channelData;
+    for (const auto textureAsset : textureAssets)
+    {
+        channelIndices.push_back(std::min(*textureAsset->GetChannelIndex(), nrComponents - 1));
+        channels.push_back(PixelBuffer::Allocate(pixelCount));
+        channelData.push_back(channels.back().GetData());
+    }
+
+    // Walk the image once and scatter every requested channel, instead of one pass per texture
+    for (size_t pixel = 0; pixel < pixelCount; pixel++)
+    {
+        const unsigned char* source = pixels + pixel * nrComponents;
+        for (size_t i = 0; i < channelData.size(); i++)
+            channelData[i][pixel] = source[channelIndices[i]];
+    }
+
+    for (size_t i = 0; i < textureAssets.size(); i++)
     {
-        textureAsset->SetTextureData(resizedData ? resizedData : loadedData);
-        stbi_image_free(resizedData ? resizedData : loadedData);
+        *textureAssets[i]->GetNrComponents() = 1;
+        textureAssets[i]->SetTextureData(std::move(channels[i]));
     }
 }
 
@@ -405,8 +1003,8 @@ void AssetManager::loadDefaultMeshAndTextures()
     std::vector<uint32_t> defaultIndices;
 
     const std::string defaultMeshPath = std::string("default");
-    m_LoadedMeshAssets[defaultMeshPath] =
-        CreateScope<MeshAsset>(IdManager::GetInstance().CreateNewId(), defaultMeshPath, defaultVertices, defaultIndices);
+    storeMesh(defaultMeshPath, CreateScope<MeshAsset>(IdManager::GetInstance().CreateNewId(), defaultMeshPath,
+                                                      defaultVertices, defaultIndices));
 
     //Default "Prototype" Texture
     std::string defaultTexturePath("assets/textures/default.png");
@@ -415,8 +1013,7 @@ void AssetManager::loadDefaultMeshAndTextures()
     nodeHandle.key() = "default";
     m_LoadedTextureAssets.insert(std::move(nodeHandle));
     const uint32_t defaultMaterialId = IdManager::GetInstance().CreateNewId();
-    m_LoadedMaterialAssets[defaultMaterialId] = CreateScope<MaterialAsset>(defaultMaterialId, "Default");
-    const auto defaultMaterial = m_LoadedMaterialAssets[defaultMaterialId].get();
+    const auto defaultMaterial = storeMaterial(CreateScope<MaterialAsset>(defaultMaterialId, "Default"));
     defaultMaterial->GetDiffusePath() = "default";
     *defaultMaterial->GetDiffuseTextureAsset() = defaultTextureAsset;
  
@@ -435,7 +1032,8 @@ void AssetManager::loadDefaultMeshAndTextures()
     m_LoadedTextureAssets.insert(std::move(nodeHandleBlack));
 }
 
-void AssetManager::processNode(const aiNode* node, const aiScene* scene, std::vector<SubModel>& subModels, const std::string& path)
+void AssetManager::processNode(const aiNode* node, const aiScene* scene, std::vector<SubModel>& subModels,
+                               ModelImportContext& context)
 {
     SubModel subModelNode;
     subModelNode.name = node->mName.C_Str();
@@ -448,27 +1046,180 @@ void AssetManager::processNode(const aiNode* node, const aiScene* scene, std::ve
     for (unsigned int i = 0; i < node->mNumMeshes; i++)
     {
         SubModel subModelMesh;
-        aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
+        const uint32_t meshIndex = node->mMeshes[i];
+        const aiMesh* mesh = scene->mMeshes[meshIndex];
         subModelMesh.name = mesh->mName.C_Str();
-        subModelMesh.mesh = processMesh(mesh, scene, path);
-        processMaterials(scene, subModelMesh, path, mesh->mMaterialIndex);
+        subModelMesh.mesh = m_MeshRegistry.GetHandle(prepareMesh(mesh, meshIndex, context)->GetId());
+        subModelMesh.material = m_MaterialRegistry.GetHandle(prepareMaterial(mesh->mMaterialIndex, context)->GetId());
         subModelNode.subModels.push_back(subModelMesh);
     }
     // then do the same for each of its children
     for (unsigned int i = 0; i < node->mNumChildren; i++)
     {
-        processNode(node->mChildren[i], scene, subModelNode.subModels, path);
+        processNode(node->mChildren[i], scene, subModelNode.subModels, context);
     }
     subModels.push_back(subModelNode);
 }
 
-MeshAsset* AssetManager::processMesh(aiMesh* mesh, const aiScene* scene, const std::string& path)
+MeshAsset* AssetManager::registerMesh(Scope<MeshAsset>& meshAsset, const uint64_t contentHash)
+{
+    if (const auto it = m_MeshesByContentHash.find(contentHash); it != m_MeshesByContentHash.end())
+    {
+        // Equal hashes are only a hint, the data decides. The existing mesh may have released its data, the counts
+        // are kept for that so most mismatches are found without restoring it. A restore that is still running on a
+        // worker has to finish first.
+        MeshAsset* existingMesh = it->second;
+        waitForMeshLoad(existingMesh->GetId());
+        if (existingMesh->GetVertexCount() == meshAsset->GetVertexCount() &&
+            existingMesh->GetIndexCount() == meshAsset->GetIndexCount() && RequireMeshData(existingMesh) &&
+            isMeshContentEqual(existingMesh, meshAsset.get()))
+        {
+            m_MeshAliases[meshAsset->GetPath()] = existingMesh;
+            m_MeshRegistry.Remove(meshAsset->GetId());
+            return existingMesh;
+        }
+    }
+
+    MeshAsset* mesh = meshAsset.get();
+    m_MeshesByContentHash.try_emplace(contentHash, mesh);
+    const std::string meshPath = mesh->GetPath();
+    storeMesh(meshPath, std::move(meshAsset));
+
+    return mesh;
+}
+
+MeshAsset* AssetManager::storeMesh(const std::string& path, Scope<MeshAsset>&& meshAsset)
 {
-    std::string meshPath = path + '@' + mesh->mName.C_Str();
-    m_LoadedMeshAssets[meshPath] = CreateScope<MeshAsset>(IdManager::GetInstance().CreateNewId(), meshPath);
+    if (const auto it = m_LoadedMeshAssets.find(path); it != m_LoadedMeshAssets.end() && it->second)
+        m_MeshRegistry.Remove(it->second->GetId());
 
-    auto& vertices = m_LoadedMeshAssets[meshPath]->GetVertices();
-    auto& indices = m_LoadedMeshAssets[meshPath]->GetIndices();
+    MeshAsset* mesh = meshAsset.get();
+    m_MeshRegistry.Insert(mesh);
+    m_LoadedMeshAssets[path] = std::move(meshAsset);
+
+    return mesh;
+}
+
+TextureAsset* AssetManager::storeTexture(const std::string& path, Scope<TextureAsset>&& textureAsset)
+{
+    if (const auto it = m_LoadedTextureAssets.find(path); it != m_LoadedTextureAssets.end() && it->second)
+        m_TextureRegistry.Remove(it->second->GetId());
+
+    TextureAsset* texture = textureAsset.get();
+    m_TextureRegistry.Insert(texture);
+    m_FileWatcher->Watch(texture->GetPath());
+    m_LoadedTextureAssets[path] = std::move(textureAsset);
+
+    return texture;
+}
+
+MaterialAsset* AssetManager::storeMaterial(Scope<MaterialAsset>&& materialAsset)
+{
+    MaterialAsset* material = materialAsset.get();
+    const uint32_t id = material->GetId();
+    releaseMaterialName(id);
+    m_MaterialRegistry.Insert(material);
+    indexMaterialName(id, material->GetName());
+    m_LoadedMaterialAssets[id] = std::move(materialAsset);
+
+    return material;
+}
+
+void AssetManager::indexMaterialName(const uint32_t id, const std::string& name)
+{
+    m_MaterialIdsByName[name].push_back(id);
+    m_MaterialNames[id] = name;
+}
+
+void AssetManager::releaseMaterialName(const uint32_t id)
+{
+    const auto nameIt = m_MaterialNames.find(id);
+    if (nameIt == m_MaterialNames.end())
+        return;
+
+    if (const auto it = m_MaterialIdsByName.find(nameIt->second); it != m_MaterialIdsByName.end())
+    {
+        std::erase(it->second, id);
+        if (it->second.empty())
+            m_MaterialIdsByName.erase(it);
+    }
+    m_MaterialNames.erase(nameIt);
+}
+
+uint64_t AssetManager::hashMeshContent(const std::vector<MeshVertex>& vertices, const std::vector<uint32_t>& indices)
+{
+    const uint64_t hash = FileUtils::HashFast(vertices.data(), vertices.size() * sizeof(MeshVertex));
+    return FileUtils::HashFast(indices.data(), indices.size() * sizeof(uint32_t), hash);
+}
+
+bool AssetManager::isMeshContentEqual(MeshAsset* meshAsset, MeshAsset* otherMeshAsset)
+{
+    // Compared bytewise like the hash, MeshVertex has no padding and is zero initialized
+    const auto& vertices = meshAsset->GetVertices();
+    const auto& otherVertices = otherMeshAsset->GetVertices();
+    const auto& indices = meshAsset->GetIndices();
+    const auto& otherIndices = otherMeshAsset->GetIndices();
+    return vertices.size() == otherVertices.size() && indices.size() == otherIndices.size() &&
+        std::memcmp(vertices.data(), otherVertices.data(), vertices.size() * sizeof(MeshVertex)) == 0 &&
+        std::memcmp(indices.data(), otherIndices.data(), indices.size() * sizeof(uint32_t)) == 0;
+}
+
+void AssetManager::remapMeshes(std::vector<SubModel>& subModels,
+                               const std::unordered_map<uint32_t, MeshAsset*>& meshMapping)
+{
+    for (auto& subModel : subModels)
+    {
+        if (const auto it = meshMapping.find(subModel.mesh.id); it != meshMapping.end())
+            subModel.mesh = m_MeshRegistry.GetHandle(it->second->GetId());
+        remapMeshes(subModel.subModels, meshMapping);
+    }
+}
+
+MeshAsset* AssetManager::prepareMesh(const aiMesh* mesh, const uint32_t meshIndex, ModelImportContext& context)
+{
+    if (context.meshes[meshIndex])
+        return context.meshes[meshIndex];
+
+    std::string meshPath = context.path + '@' + mesh->mName.C_Str();
+    if (m_LoadedMeshAssets.contains(meshPath) || context.meshPaths.contains(meshPath))
+        meshPath += '#' + std::to_string(meshIndex);
+    context.meshPaths.insert(meshPath);
+
+    // Registered right away so the SubModels can hold a handle, registerMesh removes it again if it is a duplicate
+    auto meshAsset = CreateScope<MeshAsset>(IdManager::GetInstance().CreateNewId(), meshPath);
+    m_MeshRegistry.Insert(meshAsset.get());
+    context.meshes[meshIndex] = meshAsset.get();
+    context.newMeshes.emplace_back(meshIndex, std::move(meshAsset));
+
+    return context.meshes[meshIndex];
+}
+
+MaterialAsset* AssetManager::prepareMaterial(const uint32_t materialIndex, ModelImportContext& context)
+{
+    if (context.materials[materialIndex])
+        return context.materials[materialIndex];
+
+    const std::string materialName = context.path + '@' + std::to_string(materialIndex);
+    MaterialAsset* materialAsset = GetMaterial(materialName);
+    if (!materialAsset)
+    {
+        const uint32_t materialAssetId = IdManager::GetInstance().CreateNewId();
+        auto newMaterialAsset = CreateScope<MaterialAsset>(materialAssetId, materialName);
+        materialAsset = newMaterialAsset.get();
+        m_MaterialRegistry.Insert(materialAsset);
+        context.newMaterials.emplace_back(materialIndex, std::move(newMaterialAsset));
+    }
+    context.materials[materialIndex] = materialAsset;
+
+    return materialAsset;
+}
+
+void AssetManager::processMesh(const aiMesh* mesh, MeshAsset* meshAsset, const bool generateTangents)
+{
+    auto& vertices = meshAsset->GetVertices();
+    auto& indices = meshAsset->GetIndices();
+    vertices.reserve(mesh->mNumVertices);
+    indices.reserve(static_cast<size_t>(mesh->mNumFaces) * 3);
 
     for (unsigned int i = 0; i < mesh->mNumVertices; i++)
     {
@@ -493,6 +1244,12 @@ MeshAsset* AssetManager::processMesh(aiMesh* mesh, const aiScene* scene, const s
             vec.x = mesh->mTextureCoords[0][i].x;
             vec.y = mesh->mTextureCoords[0][i].y;
             vertex.TexCoords = vec;
+        }
+        else
+            vertex.TexCoords = glm::vec2(0.0f, 0.0f);
+
+        if (mesh->HasTangentsAndBitangents())
+        {
             // tangent
             vector.x = mesh->mTangents[i].x;
             vector.y = mesh->mTangents[i].y;
@@ -504,8 +1261,6 @@ MeshAsset* AssetManager::processMesh(aiMesh* mesh, const aiScene* scene, const s
             vector.z = mesh->mBitangents[i].z;
             vertex.Bitangent = vector;
         }
-        else
-            vertex.TexCoords = glm::vec2(0.0f, 0.0f);
 
         vertices.push_back(vertex);
     }
@@ -517,25 +1272,17 @@ MeshAsset* AssetManager::processMesh(aiMesh* mesh, const aiScene* scene, const s
             indices.push_back(face.mIndices[j]);
     }
 
-    // return a MeshAsset created from the extracted mesh data
-    return m_LoadedMeshAssets[meshPath].get();
+    if (generateTangents && !mesh->HasTangentsAndBitangents() && mesh->mTextureCoords[0])
+        MeshOptimizer::GenerateTangents(vertices, indices);
 }
 
-void AssetManager::processMaterials(const aiScene* scene, SubModel& subModel, const std::string& path, const uint32_t materialIndex)
+bool AssetManager::hasNormalTexture(const aiMaterial* aiMaterial)
 {
-    const std::string directory = path.substr(0, path.find_last_of('/'));
-    const std::string materialName = path + '@' + std::to_string(materialIndex);
-    MaterialAsset* materialAsset = GetMaterial(materialName);
-    if (materialAsset)
-    {
-        subModel.material = materialAsset;
-        return;
-    }
-
-    const uint32_t materialAssetId = IdManager::GetInstance().CreateNewId();
-    m_LoadedMaterialAssets[materialAssetId] = CreateScope<MaterialAsset>(materialAssetId, materialName);
-    materialAsset = m_LoadedMaterialAssets[materialAssetId].get();
+    return aiMaterial->GetTextureCount(aiTextureType_NORMALS) || aiMaterial->GetTextureCount(aiTextureType_HEIGHT);
+}
 
+void AssetManager::processMaterial(const aiMaterial* aiMaterial, const std::string& directory, MaterialAsset* materialAsset)
+{
     auto& diffusePath = materialAsset->GetDiffusePath();
     auto& normalPath = materialAsset->GetNormalPath();
     auto& metallicPath = materialAsset->GetMetallicPath();
@@ -543,8 +1290,6 @@ void AssetManager::processMaterials(const aiScene* scene, SubModel& subModel, co
     auto& aoPath = materialAsset->GetAOPath();
     auto& emissivePath = materialAsset->GetEmissivePath();
 
-    const aiMaterial* aiMaterial = scene->mMaterials[materialIndex];
-
     // 1. diffuse map
     if (aiMaterial->GetTextureCount(aiTextureType_DIFFUSE))
     {
@@ -593,28 +1338,456 @@ void AssetManager::processMaterials(const aiScene* scene, SubModel& subModel, co
         aiMaterial->GetTexture(aiTextureType_EMISSIVE, 0, &emissiveFile);
         emissivePath = directory + '/' + emissiveFile.C_Str();
     }
+}
+
+void AssetManager::processCachedNodes(std::vector<CachedNode>& nodes, std::vector<SubModel>& subModels,
+                                      const std::vector<MeshAsset*>& meshes, const std::vector<MaterialAsset*>& materials)
+{
+    for (auto& node : nodes)
+    {
+        SubModel subModel;
+        subModel.name = std::move(node.name);
+        subModel.modelMatrix = node.modelMatrix;
+        if (node.meshIndex >= 0)
+            subModel.mesh = m_MeshRegistry.GetHandle(meshes[node.meshIndex]->GetId());
+        if (node.materialIndex >= 0)
+            subModel.material = m_MaterialRegistry.GetHandle(materials[node.materialIndex]->GetId());
+        processCachedNodes(node.children, subModel.subModels, meshes, materials);
+        subModels.push_back(std::move(subModel));
+    }
+}
+
+void AssetManager::registerMaterialTextures(MaterialAsset* materialAsset)
+{
+    auto registerSlot = [this](std::string& path, bool flip, TextureAsset** textureAsset, MaterialTextureSlot slot,
+                               bool loadOnlyOneChannel = false, int channelIndex = 0) {
+        if (path.empty())
+            return;
+
+        bool needsImport;
+        *textureAsset = registerTexture(path, flip, loadOnlyOneChannel, channelIndex, slot, needsImport);
+    };
+
+    // Packed metallic/roughness (glTF) or occlusion/roughness/metallic textures are split into single channels
+    const bool metalRoughnessIsShared = materialAsset->GetMetallicPath() == materialAsset->GetRoughnessPath();
+    const bool aoIsPacked = metalRoughnessIsShared && materialAsset->GetAOPath() == materialAsset->GetMetallicPath();
+    registerSlot(materialAsset->GetDiffusePath(), materialAsset->GetFlipDiffuseTexture(),
+                 materialAsset->GetDiffuseTextureAsset(), MaterialTextureSlot::DIFFUSE);
+    registerSlot(materialAsset->GetNormalPath(), materialAsset->GetFlipNormalTexture(),
+                 materialAsset->GetNormalTextureAsset(), MaterialTextureSlot::NORMAL);
+    registerSlot(materialAsset->GetMetallicPath(), materialAsset->GetFlipMetallicTexture(),
+                 materialAsset->GetMetallicTextureAsset(), MaterialTextureSlot::METALLIC, metalRoughnessIsShared, 2);
+    registerSlot(materialAsset->GetRoughnessPath(), materialAsset->GetFlipRoughnessTexture(),
+                 materialAsset->GetRoughnessTextureAsset(), MaterialTextureSlot::ROUGHNESS, metalRoughnessIsShared, 1);
+    registerSlot(materialAsset->GetAOPath(), materialAsset->GetFlipAOTexture(), materialAsset->GetAOTextureAsset(),
+                 MaterialTextureSlot::AO, aoIsPacked, 0);
+    registerSlot(materialAsset->GetEmissivePath(), materialAsset->GetFlipEmissiveTexture(),
+                 materialAsset->GetEmissiveTextureAsset(), MaterialTextureSlot::EMISSIVE);
+}
+
+void AssetManager::importTextureAsync(TextureAsset* textureAsset)
+{
+    importTexturesAsync({textureAsset});
+}
+
+void AssetManager::importTexturesAsync(const std::vector<TextureAsset*>& textureAssets)
+{
+    std::erase_if(m_PendingTextureImports, [](const auto& pendingImport) {
+        return pendingImport.second.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    });
+
+    // Channels of packed textures (e.g. metallic/roughness/AO) are imported together, so the file is decoded once
+    std::unordered_map<std::string, std::vector<TextureAsset*>> texturesBySource;
+    for (const auto textureAsset : textureAssets)
+    {
+        waitForTextureImport(textureAsset->GetId());
+        textureAsset->SetLoading(true);
+        // The new data is needed for the next upload, it must not be released before
+        m_UploadedTextures.erase(textureAsset->GetId());
+        const std::string sourceKey = textureAsset->GetPath() + (textureAsset->GetFlipVertical() ? "#flipped" : "");
+        texturesBySource[sourceKey].push_back(textureAsset);
+    }
+
+    for (auto& textures : texturesBySource | std::views::values)
+    {
+        const std::shared_future<void> pendingImport =
+            ThreadPool::GetInstance()
+                .Submit([this, textures, sizePolicy = m_TextureSizePolicy]() {
+                    const auto importStart = std::chrono::steady_clock::now();
+                    importTextures(textures, sizePolicy);
+                    // The file was decoded once for all of them
+                    const int64_t loadTime = ImportReport::GetElapsedTime(importStart) / static_cast<int64_t>(textures.size());
+                    for (const auto textureAsset : textures)
+                    {
+                        textureAsset->SetLoadTime(loadTime);
+                        textureAsset->SetLoading(false);
+                    }
+                })
+                .share();
+        for (const auto textureAsset : textures)
+            m_PendingTextureImports[textureAsset->GetId()] = pendingImport;
+    }
+}
+
+void AssetManager::waitForTextureImport(const uint32_t textureId)
+{
+    if (!m_PendingTextureImports.contains(textureId))
+        return;
+
+    m_PendingTextureImports[textureId].wait();
+    m_PendingTextureImports.erase(textureId);
+}
+
+void AssetManager::importEnvironmentMapAsync(EnvironmentMap* environmentMap)
+{
+    if (const auto it = m_PendingEnvironmentMapImports.find(environmentMap->GetId()); it != m_PendingEnvironmentMapImports.end())
+    {
+        it->second.wait();
+        m_PendingEnvironmentMapImports.erase(it);
+    }
+
+    environmentMap->SetLoading(true);
+    m_PendingEnvironmentMapImports[environmentMap->GetId()] =
+        ThreadPool::GetInstance()
+            .Submit([this, environmentMap]() {
+                if (!m_TextureCache->Read(environmentMap))
+                {
+                    stbi_set_flip_vertically_on_load_thread(false);
+                    int32_t width, height, nrComponents;
+                    float* pixels = stbi_loadf(environmentMap->GetPath().c_str(), &width, &height, &nrComponents, 3);
+                    if (pixels)
+                    {
+                        environmentMap->ConvertEquirectangular(pixels, width, height);
+                        stbi_image_free(pixels);
+                        m_TextureCache->Write(environmentMap);
+                    }
+                    else
+                    {
+                        SPDLOG_DEBUG("Could not load environment map " + environmentMap->GetPath() + ": " +
+                                     stbi_failure_reason());
+                        // Without mip levels it counts as failed and isn't requested again until the file changes
+                        environmentMap->SetData(0, PixelBuffer(), {});
+                    }
+                }
+                environmentMap->SetLoading(false);
+            })
+            .share();
+}
+
+void AssetManager::restoreMeshData(const MeshSource& source, const std::vector<MeshAsset*>& meshAssets) const
+{
+    // The source file may have changed since, the cache still holds the data that was uploaded
+    CachedModel cachedModel;
+    if (!m_ModelCache->Read(source.modelPath, source.importProfile, cachedModel, false))
+    {
+        SPDLOG_DEBUG("Could not restore the meshes of " + source.modelPath + ", the model cache entry is missing");
+        return;
+    }
 
-    const bool metalRoughnessIsShared = metallicPath == roughnessPath;
-    if (!diffusePath.empty())
-        *materialAsset->GetDiffuseTextureAsset() = LoadTexture(diffusePath, materialAsset->GetFlipDiffuseTexture());
-    if (!normalPath.empty())
-        *materialAsset->GetNormalTextureAsset() = LoadTexture(normalPath, materialAsset->GetFlipNormalTexture());
-    if (!metallicPath.empty())
-        *materialAsset->GetMetallicTextureAsset() = LoadTexture(metallicPath, materialAsset->GetFlipMetallicTexture(), metalRoughnessIsShared, 2);
-    if (!roughnessPath.empty())
-        *materialAsset->GetRoughnessTextureAsset() = LoadTexture(roughnessPath, materialAsset->GetFlipRoughnessTexture(), metalRoughnessIsShared, 1);
-    if (!aoPath.empty())
-        *materialAsset->GetAOTextureAsset() = LoadTexture(aoPath, materialAsset->GetFlipAOTexture());
-    if (!emissivePath.empty())
-        *materialAsset->GetEmissiveTextureAsset() = LoadTexture(emissivePath, materialAsset->GetFlipEmissiveTexture());
+    for (const auto meshAsset : meshAssets)
+    {
+        const auto it = std::ranges::find(cachedModel.meshes, meshAsset->GetPath(), &CachedMesh::path);
+        if (it == cachedModel.meshes.end())
+        {
+            SPDLOG_DEBUG("Could not restore " + meshAsset->GetPath() + ", it is not in the model cache");
+            continue;
+        }
+        meshAsset->RestoreData(std::move(it->vertices), std::move(it->indices), std::move(it->lods),
+                               std::move(it->meshlets));
+    }
+}
+
+void AssetManager::waitForMeshLoad(const uint32_t meshId)
+{
+    if (!m_PendingMeshLoads.contains(meshId))
+        return;
+
+    m_PendingMeshLoads[meshId].wait();
+    m_PendingMeshLoads.erase(meshId);
+}
+
+void AssetManager::releaseMeshData(MeshAsset* meshAsset)
+{
+    waitForMeshLoad(meshAsset->GetId());
+    meshAsset->ReleaseData();
+}
 
-    subModel.material = materialAsset;
+bool AssetManager::requireModelMeshData(const std::vector<SubModel>& subModels)
+{
+    std::vector<MeshAsset*> meshes;
+    std::vector<const std::vector<SubModel>*> pendingSubModels = {&subModels};
+    while (!pendingSubModels.empty())
+    {
+        const auto currentSubModels = pendingSubModels.back();
+        pendingSubModels.pop_back();
+        for (const auto& subModel : *currentSubModels)
+        {
+            MeshAsset* meshAsset = m_MeshRegistry.Get(subModel.mesh);
+            if (meshAsset && std::ranges::find(meshes, meshAsset) == meshes.end())
+                meshes.push_back(meshAsset);
+            pendingSubModels.push_back(&subModel.subModels);
+        }
+    }
+
+    LoadMeshDataAsync(meshes);
+    bool allResident = true;
+    for (const auto meshAsset : meshes)
+        allResident &= RequireMeshData(meshAsset);
+
+    return allResident;
+}
+
+void AssetManager::cacheModel(const std::string& path, const ImportProfile importProfile, const Model& model)
+{
+    if (!requireModelMeshData(model.subModels))
+    {
+        SPDLOG_ERROR("Could not cache " + path + ", the data of a shared mesh could not be restored");
+        return;
+    }
+    if (m_ModelCache->Write(path, importProfile, model))
+        registerMeshSources(model.subModels, {path, importProfile});
+}
+
+void AssetManager::registerMeshSources(const std::vector<SubModel>& subModels, const MeshSource& source)
+{
+    // Meshes shared with other models are stored in the cache entry under their own model's path
+    const std::string meshPathPrefix = source.modelPath + '@';
+    std::vector<const std::vector<SubModel>*> pendingSubModels = {&subModels};
+    while (!pendingSubModels.empty())
+    {
+        const auto currentSubModels = pendingSubModels.back();
+        pendingSubModels.pop_back();
+        for (const auto& subModel : *currentSubModels)
+        {
+            const MeshAsset* meshAsset = m_MeshRegistry.Get(subModel.mesh);
+            if (meshAsset && meshAsset->GetPath().starts_with(meshPathPrefix))
+                m_MeshSources.try_emplace(meshAsset->GetId(), source);
+            pendingSubModels.push_back(&subModel.subModels);
+        }
+    }
+}
+
+void AssetManager::reportDataSize(const std::string& category, const uint32_t id, const std::string& name,
+                                  const size_t dataSize)
+{
+    const auto it = m_ReportedDataSizes.find(id);
+    if (it != m_ReportedDataSizes.end() && it->second == dataSize)
+        return;
+
+    if (dataSize)
+    {
+        MemoryTracker::GetInstance().Track(category, id, name, dataSize);
+        m_ReportedDataSizes[id] = dataSize;
+    }
+    else
+    {
+        MemoryTracker::GetInstance().Untrack(category, id);
+        m_ReportedDataSizes.erase(id);
+    }
+}
+
+MeshAsset* AssetManager::findFirstMesh(const std::vector<SubModel>& subModels) const
+{
+    for (const auto& subModel : subModels)
+    {
+        if (MeshAsset* mesh = m_MeshRegistry.Get(subModel.mesh))
+            return mesh;
+        if (MeshAsset* mesh = findFirstMesh(subModel.subModels))
+            return mesh;
+    }
+
+    return nullptr;
+}
+
+void AssetManager::watchShaderIncludes(const std::string& shaderPath, const std::string& sourcePath)
+{
+    std::ifstream stream(sourcePath);
+    const std::string directory = sourcePath.substr(0, sourcePath.find_last_of('/') + 1);
+    std::string line;
+    while (std::getline(stream, line))
+    {
+        if (!line.starts_with("#include"))
+            continue;
+
+        const size_t nameStart = line.find('"');
+        const size_t nameEnd = line.find('"', nameStart + 1);
+        if (nameStart == std::string::npos || nameEnd == std::string::npos)
+            continue;
+
+        const std::string includePath = directory + line.substr(nameStart + 1, nameEnd - nameStart - 1);
+        if (!m_ShaderIncludes[includePath].insert(shaderPath).second)
+            continue;
+        m_FileWatcher->Watch(includePath);
+        watchShaderIncludes(shaderPath, includePath);
+    }
+}
+
+void AssetManager::reloadShaders(const std::string& path)
+{
+    std::unordered_set<std::string> shaderPaths;
+    if (m_LoadedShaders.contains(path))
+        shaderPaths.insert(path);
+    if (const auto it = m_ShaderIncludes.find(path); it != m_ShaderIncludes.end())
+        shaderPaths.insert(it->second.begin(), it->second.end());
+
+    for (const auto& shaderPath : shaderPaths)
+    {
+        SPDLOG_DEBUG("Recompiling " + shaderPath);
+        m_LoadedShaders[shaderPath]->RecompileFromSource();
+        // The change may have added includes
+        watchShaderIncludes(shaderPath, shaderPath);
+    }
+}
+
+void AssetManager::reloadModel(const std::string& path, const ImportProfile importProfile)
+{
+    SPDLOG_DEBUG("Reloading " + path + " (" + ImportSettings::Get(importProfile).name + ")");
+
+    // The meshes of the model are taken out, so the import creates new ones under the same paths. Unchanged meshes
+    // are found again by their content and only get an alias.
+    const std::string meshPathPrefix = path + '@';
+    std::unordered_map<std::string, Scope<MeshAsset>> previousMeshes;
+    for (auto it = m_LoadedMeshAssets.begin(); it != m_LoadedMeshAssets.end();)
+    {
+        if (it->first.starts_with(meshPathPrefix))
+        {
+            previousMeshes.emplace(it->first, std::move(it->second));
+            it = m_LoadedMeshAssets.erase(it);
+        }
+        else
+            ++it;
+    }
+    std::unordered_map<std::string, MeshAsset*> previousAliases;
+    for (auto it = m_MeshAliases.begin(); it != m_MeshAliases.end();)
+    {
+        if (it->first.starts_with(meshPathPrefix))
+        {
+            previousAliases.emplace(it->first, it->second);
+            it = m_MeshAliases.erase(it);
+        }
+        else
+            ++it;
+    }
+    Scope<Model> previousModel = std::move(m_LoadedModels[path]);
+    m_LoadedModels.erase(path);
+
+    Model* model = LoadModel(path, importProfile);
+    if (!model)
+    {
+        // The file may still be written, keep the previous state
+        for (auto& [meshPath, meshAsset] : previousMeshes)
+            m_LoadedMeshAssets[meshPath] = std::move(meshAsset);
+        m_MeshAliases.insert(previousAliases.begin(), previousAliases.end());
+        m_LoadedModels[path] = std::move(previousModel);
+        return;
+    }
+
+    // The new data of changed meshes is moved into the previous assets, everything keeps pointing to those
+    std::unordered_map<uint32_t, MeshAsset*> meshMapping;
+    for (auto& [meshPath, previousMesh] : previousMeshes)
+    {
+        MeshAsset* mesh = previousMesh.get();
+        const auto it = m_LoadedMeshAssets.find(meshPath);
+        if (it == m_LoadedMeshAssets.end())
+        {
+            if (const auto aliasIt = m_MeshAliases.find(meshPath); aliasIt != m_MeshAliases.end() && aliasIt->second == mesh)
+                m_MeshAliases.erase(aliasIt);
+            m_LoadedMeshAssets[meshPath] = std::move(previousMesh);
+            continue;
+        }
+
+        MeshAsset* newMesh = it->second.get();
+        waitForMeshLoad(mesh->GetId());
+        mesh->RestoreData(std::move(newMesh->GetVertices()), std::move(newMesh->GetIndices()),
+                          std::move(newMesh->GetLods()), std::move(newMesh->GetMeshlets()));
+        for (auto hashIt = m_MeshesByContentHash.begin(); hashIt != m_MeshesByContentHash.end();)
+        {
+            if (hashIt->second == mesh)
+            {
+                hashIt = m_MeshesByContentHash.erase(hashIt);
+                continue;
+            }
+            if (hashIt->second == newMesh)
+                hashIt->second = mesh;
+            ++hashIt;
+        }
+        for (auto& aliasedMesh : m_MeshAliases | std::views::values)
+        {
+            if (aliasedMesh == newMesh)
+                aliasedMesh = mesh;
+        }
+        meshMapping[newMesh->GetId()] = mesh;
+        m_MeshRegistry.Remove(newMesh->GetId());
+        // Without a source the new cache entry could not be written, the previous one does not match the data anymore
+        if (const auto sourceIt = m_MeshSources.find(newMesh->GetId()); sourceIt != m_MeshSources.end())
+        {
+            const MeshSource source = sourceIt->second;
+            m_MeshSources.erase(sourceIt);
+            m_MeshSources[mesh->GetId()] = source;
+        }
+        else
+            m_MeshSources.erase(mesh->GetId());
+        it->second = std::move(previousMesh);
+        m_ChangedMeshes.push_back(mesh);
+    }
+    remapMeshes(model->subModels, meshMapping);
+
+    // Data released from here on is restored from the cache entry of the new import
+    for (auto& source : m_MeshSources | std::views::values)
+    {
+        if (source.modelPath == path)
+            source.importProfile = importProfile;
+    }
+}
+
+void AssetManager::addImportReport(ImportReport&& report, const Model* model)
+{
+    std::vector<const std::vector<SubModel>*> pendingSubModels = {&model->subModels};
+    while (!pendingSubModels.empty())
+    {
+        const auto currentSubModels = pendingSubModels.back();
+        pendingSubModels.pop_back();
+        for (const auto& subModel : *currentSubModels)
+        {
+            pendingSubModels.push_back(&subModel.subModels);
+            MaterialAsset* materialAsset = m_MaterialRegistry.Get(subModel.material);
+            if (!materialAsset)
+                continue;
+
+            for (TextureAsset** textureAsset :
+                 {materialAsset->GetDiffuseTextureAsset(), materialAsset->GetNormalTextureAsset(),
+                  materialAsset->GetMetallicTextureAsset(), materialAsset->GetRoughnessTextureAsset(),
+                  materialAsset->GetAOTextureAsset(), materialAsset->GetEmissiveTextureAsset()})
+            {
+                if (*textureAsset && std::ranges::find(report.textureIds, (*textureAsset)->GetId()) == report.textureIds.end())
+                    report.textureIds.push_back((*textureAsset)->GetId());
+            }
+        }
+    }
+
+    SPDLOG_DEBUG("Imported " + report.path + " (" + ImportSettings::Get(report.profile).name +
+                 (report.fromCache ? ", cached" : "") + "): parse " + std::to_string(report.parseTime) +
+                 "us, post-process " + std::to_string(report.postProcessTime) + "us, conversion " +
+                 std::to_string(report.conversionTime) + "us, optimization " + std::to_string(report.optimizationTime) +
+                 "us");
+    m_ImportReports.push_back(std::move(report));
+}
+
+MeshAsset* SubModel::GetMesh() const
+{
+    return AssetManager::GetInstance().GetMesh(mesh);
+}
+
+MaterialAsset* SubModel::GetMaterial() const
+{
+    return AssetManager::GetInstance().GetMaterial(material);
 }
 
 nlohmann::ordered_json Model::SerializeObject()
 {
     nlohmann::ordered_json model = {
         {"Name", name},
+        {"ImportProfile", static_cast<uint32_t>(importProfile)},
         {"SubModels", addSubModelJson(subModels)}
     };
 
@@ -624,6 +1797,8 @@ nlohmann::ordered_json Model::SerializeObject()
 void Model::DeserializeObject(nlohmann::json jsonObject)
 {
     name = jsonObject["Name"];
+    if (jsonObject.contains("ImportProfile"))
+        importProfile = static_cast<ImportProfile>(static_cast<uint32_t>(jsonObject["ImportProfile"]));
     subModels = deserializeSubModels(jsonObject["SubModels"]);
 }
 
@@ -654,12 +1829,12 @@ std::vector<SubModel>&& Model::deserializeSubModels(nlohmann::json subModelsJson
         if (subModelJson.contains("MeshAssetId"))
         {
             const uint32_t meshAssetId = subModelJson["MeshAssetId"];
-            subModel.mesh = AssetManager::GetInstance().GetMesh(meshAssetId);
+            subModel.mesh = AssetManager::GetInstance().GetMeshHandle(meshAssetId);
         }
         if (subModelJson.contains("MaterialAssetId"))
         {
             const uint32_t materialAssetId = subModelJson["MaterialAssetId"];
-            subModel.material = AssetManager::GetInstance().GetMaterial(materialAssetId);
+            subModel.material = AssetManager::GetInstance().GetMaterialHandle(materialAssetId);
         }
         if (subModelJson.contains("SubModels"))
             subModel.subModels = deserializeSubModels(subModelJson["SubModels"]);
@@ -695,10 +1870,10 @@ nlohmann::ordered_json Model::addSubModelJson(std::vector<SubModel>& subModels)
                                 {"13", subModel.modelMatrix[3][1]},
                                 {"14", subModel.modelMatrix[3][2]},
                                 {"15", subModel.modelMatrix[3][3]}}}};
-        if (subModel.mesh)
-            subModelsArray[i]["MeshAssetId"] = subModel.mesh->GetId();
-        if (subModel.material)
-            subModelsArray[i]["MaterialAssetId"] = subModel.material->GetId();
+        if (const MeshAsset* meshAsset = subModel.GetMesh())
+            subModelsArray[i]["MeshAssetId"] = meshAsset->GetId();
+        if (const MaterialAsset* materialAsset = subModel.GetMaterial())
+            subModelsArray[i]["MaterialAssetId"] = materialAsset->GetId();
         nlohmann::ordered_json nextSubModels = addSubModelJson(subModel.subModels);
         if (!nextSubModels.empty())
         {
@@ -1,27 +1,43 @@
 #pragma once
 #include "Base.h"
 #include "MaterialAsset.h"
+#include "Entity/Assets/AssetRegistry.h"
+#include "Entity/Assets/EnvironmentMap.h"
+#include "Entity/Assets/ImportProfile.h"
 #include "Entity/Assets/MeshAsset.h"
+#include "Entity/Assets/ModelCache.h"
+#include "Entity/Assets/ResidencyPolicy.h"
 #include "Entity/Assets/TextureAsset.h"
+#include "Entity/Assets/TextureCache.h"
+#include "Entity/Assets/TextureSizePolicy.h"
+#include "Application/Util/FileWatcher.h"
 #include "assimp/Importer.hpp"
 #include "assimp/scene.h"
 #include "assimp/postprocess.h"
 #include "json.hpp"
 
+#include <future>
+#include <unordered_set>
+
+// Holds handles to its assets, a mesh or material that got removed or replaced resolves to nullptr
 struct SubModel
 {
-    SubModel() : mesh(nullptr), material(nullptr), modelMatrix(1.0f) {}
+    SubModel() : modelMatrix(1.0f) {}
 
     std::string name;
-    MeshAsset* mesh;
-    MaterialAsset* material;
+    AssetHandle<MeshAsset> mesh;
+    AssetHandle<MaterialAsset> material;
     std::vector<SubModel> subModels;
     glm::mat4 modelMatrix;
+
+    MeshAsset* GetMesh() const;
+    MaterialAsset* GetMaterial() const;
 };
 struct Model
 {
     std::string name;
     std::vector<SubModel> subModels;
+    ImportProfile importProfile = ImportProfile::FULL_QUALITY;
 
     nlohmann::ordered_json SerializeObject();
     void DeserializeObject(nlohmann::json jsonObject);
@@ -29,6 +45,16 @@ struct Model
     static std::vector<SubModel>&& deserializeSubModels(nlohmann::json subModelsJsonArr);
 };
 
+// Assets whose files changed on disk and that were re-imported, their proxies have to be updated
+struct AssetChanges
+{
+    std::vector<MeshAsset*> meshes;
+    // Not re-imported yet, the ProxyManager decides when the new data is needed
+    std::vector<TextureAsset*> textures;
+    // Already imported again in the background
+    std::vector<EnvironmentMap*> environmentMaps;
+};
+
 class AssetManager
 {
 public:
@@ -41,19 +67,59 @@ public:
         return instance;
     }
 
-    MeshAsset* LoadMesh(const std::string& path);
+    MeshAsset* LoadMesh(const std::string& path, ImportProfile importProfile = ImportProfile::FULL_QUALITY);
     MeshAsset* GetMesh(const uint32_t id);
-    TextureAsset* LoadTexture(std::string& path, bool flipVertical, bool loadOnlyOneChannel = false, int channelIndex = 0);
+    MeshAsset* GetMesh(AssetHandle<MeshAsset> handle) const { return m_MeshRegistry.Get(handle); }
+    AssetHandle<MeshAsset> GetMeshHandle(const uint32_t id) const { return m_MeshRegistry.GetHandle(id); }
+    // Restores released mesh data from the model cache in the background. Check MeshAsset::IsLoading before use
+    void LoadMeshDataAsync(const std::vector<MeshAsset*>& meshAssets);
+    // Blocks until the data of the mesh is on the CPU. Returns false if released data couldn't be restored
+    bool RequireMeshData(MeshAsset* meshAsset);
+    TextureAsset* LoadTexture(std::string& path, bool flipVertical, bool loadOnlyOneChannel = false, int channelIndex = 0,
+                              MaterialTextureSlot slot = MaterialTextureSlot::NONE);
+    // Returns immediately, the texture data is decoded on the worker threads. Check TextureAsset::IsLoading before use.
+    TextureAsset* LoadTextureAsync(std::string& path, bool flipVertical, bool loadOnlyOneChannel = false, int channelIndex = 0,
+                                   MaterialTextureSlot slot = MaterialTextureSlot::NONE);
     void ReloadTexture(TextureAsset* textureAsset);
+    void ReloadTextureAsync(TextureAsset* textureAsset);
+    // Imports registered textures in the background, channels of the same source file are decoded together
+    void LoadTexturesAsync(const std::vector<TextureAsset*>& textureAssets);
+    // Returns immediately, the HDR image is converted to a cubemap (or read from the texture cache) on the worker
+    // threads. Check EnvironmentMap::IsLoading before use, released data is imported again by calling it again.
+    EnvironmentMap* LoadEnvironmentMapAsync(const std::string& path);
+    // Applies to textures imported afterwards, already baked textures get rebaked when their cache entry is read
+    void SetTextureSizePolicy(const TextureSizePolicy& sizePolicy);
+    const TextureSizePolicy& GetTextureSizePolicy() const { return m_TextureSizePolicy; }
+    void SetResidencyPolicy(const ResidencyPolicy& residencyPolicy);
+    const ResidencyPolicy& GetResidencyPolicy() const { return m_ResidencyPolicy; }
+    // Have to be called after the data of an asset got uploaded to the GPU, the CPU copy is released by the policy
+    void OnMeshUploaded(MeshAsset* meshAsset);
+    void OnTextureUploaded(TextureAsset* textureAsset);
+    void OnEnvironmentMapUploaded(EnvironmentMap* environmentMap);
+    // Releases CPU data the residency policy doesn't allow to keep and reports the CPU data per asset category to
+    // the MemoryTracker. Call once per frame, after the uploads
+    void UpdateResidency();
     TextureAsset* GetTexture(const uint32_t id);
+    TextureAsset* GetTexture(AssetHandle<TextureAsset> handle) const { return m_TextureRegistry.Get(handle); }
+    AssetHandle<TextureAsset> GetTextureHandle(const uint32_t id) const { return m_TextureRegistry.GetHandle(id); }
     Shader* LoadShader(const std::string& path, ShaderType shaderType);
-    Model* LoadModel(const std::string& path);
+    // A model that was loaded with another profile before is imported again, into its existing assets
+    Model* LoadModel(const std::string& path, ImportProfile importProfile = ImportProfile::FULL_QUALITY);
     Model* GetModel(const std::string& path);
     MaterialAsset* GetMaterial(const std::string& name);
     MaterialAsset* GetMaterial(uint32_t id);
+    MaterialAsset* GetMaterial(AssetHandle<MaterialAsset> handle) const { return m_MaterialRegistry.Get(handle); }
+    AssetHandle<MaterialAsset> GetMaterialHandle(const uint32_t id) const { return m_MaterialRegistry.GetHandle(id); }
+    // Has to be called after the name of a material changed, so GetMaterial(name) finds it under the new name
+    void UpdateMaterialName(uint32_t id);
     MaterialAsset* CreateMaterial();
     void RemoveMaterial(uint32_t id);
     std::vector<uint32_t> GetMaterialIds(bool includeDefault) const;
+    // Recompiles shaders whose source (or one of its includes) changed and re-imports changed models into their
+    // existing mesh assets, so everything that points to them stays valid. Call once per frame
+    AssetChanges ProcessFileChanges();
+    // One per model import, in import order
+    const std::vector<ImportReport>& GetImportReports();
 
     // Used for Serialization
     std::vector<std::pair<std::string, Model*>> GetModels() const;
@@ -67,18 +133,137 @@ public:
     void AddModel(const std::string& path, Scope<Model>&& model);
 
 private:
+    // Per-import bookkeeping, indexed by aiMesh/aiMaterial index
+    struct ModelImportContext
+    {
+        std::string path;
+        std::vector<MeshAsset*> meshes;
+        std::vector<MaterialAsset*> materials;
+        std::vector<std::pair<uint32_t, Scope<MeshAsset>>> newMeshes;
+        std::vector<std::pair<uint32_t, Scope<MaterialAsset>>> newMaterials;
+        std::unordered_set<std::string> meshPaths;
+    };
+
+    struct FileHash
+    {
+        int64_t lastWriteTime;
+        uint64_t hash;
+    };
+
+    // Model whose cache entry holds a mesh
+    struct MeshSource
+    {
+        std::string modelPath;
+        ImportProfile importProfile;
+    };
+
     AssetManager();
 
     Scope<Assimp::Importer> m_Importer;
+    Scope<ModelCache> m_ModelCache;
+    Scope<TextureCache> m_TextureCache;
+    Scope<FileWatcher> m_FileWatcher;
+    TextureSizePolicy m_TextureSizePolicy;
+    ResidencyPolicy m_ResidencyPolicy;
     std::unordered_map<std::string, Scope<MeshAsset>> m_LoadedMeshAssets;
     std::unordered_map<std::string, Scope<TextureAsset>> m_LoadedTextureAssets;
     std::unordered_map<std::string, Scope<Shader>> m_LoadedShaders;
     std::unordered_map<std::string, Scope<Model>> m_LoadedModels;
     std::unordered_map<uint32_t, Scope<MaterialAsset>> m_LoadedMaterialAssets;
+    std::unordered_map<std::string, Scope<EnvironmentMap>> m_LoadedEnvironmentMaps;
+    std::unordered_map<uint32_t, std::shared_future<void>> m_PendingTextureImports;
+    std::unordered_map<uint32_t, std::shared_future<void>> m_PendingEnvironmentMapImports;
+    std::unordered_map<uint32_t, std::shared_future<void>> m_PendingMeshLoads;
+    // Meshes without a source (e.g. loaded from a scene file) always keep their data
+    std::unordered_map<uint32_t, MeshSource> m_MeshSources;
+    // Asset id -> upload counter value of its last upload, only uploaded assets can be released
+    std::unordered_map<uint32_t, uint64_t> m_UploadedMeshes;
+    std::unordered_map<uint32_t, uint64_t> m_UploadedTextures;
+    uint64_t m_UploadCounter;
+    // Asset id -> CPU data size last reported to the MemoryTracker
+    std::unordered_map<uint32_t, size_t> m_ReportedDataSizes;
+    std::vector<ImportReport> m_ImportReports;
+    // Re-imported outside of ProcessFileChanges (e.g. with another profile), handed out by its next call
+    std::vector<MeshAsset*> m_ChangedMeshes;
+    // Assets are deduplicated by content, paths of duplicates only point to the asset that was loaded first
+    std::unordered_map<uint64_t, TextureAsset*> m_TexturesByContentHash;
+    std::unordered_map<std::string, TextureAsset*> m_TextureAliases;
+    std::unordered_map<uint64_t, MeshAsset*> m_MeshesByContentHash;
+    std::unordered_map<std::string, MeshAsset*> m_MeshAliases;
+    std::unordered_map<std::string, FileHash> m_FileHashes;
+    // Included file -> shaders that include it
+    std::unordered_map<std::string, std::unordered_set<std::string>> m_ShaderIncludes;
+    // Lookup indices over the maps above, the maps own the assets
+    AssetRegistry<MeshAsset> m_MeshRegistry;
+    AssetRegistry<TextureAsset> m_TextureRegistry;
+    AssetRegistry<MaterialAsset> m_MaterialRegistry;
+    // If several materials share a name, the one registered first is found. The ids are in registration order.
+    std::unordered_map<std::string, std::vector<uint32_t>> m_MaterialIdsByName;
+    // Name each material is indexed under, its asset already has the new name when it gets renamed
+    std::unordered_map<uint32_t, std::string> m_MaterialNames;
 
+    // Insert into the owning maps and the lookup indices, an asset already stored under the key gets replaced
+    MeshAsset* storeMesh(const std::string& path, Scope<MeshAsset>&& meshAsset);
+    TextureAsset* storeTexture(const std::string& path, Scope<TextureAsset>&& textureAsset);
+    MaterialAsset* storeMaterial(Scope<MaterialAsset>&& materialAsset);
+    void indexMaterialName(uint32_t id, const std::string& name);
+    // The next material with the same name takes over the name
+    void releaseMaterialName(uint32_t id);
+    TextureAsset* registerTexture(std::string& path, bool flipVertical, bool loadOnlyOneChannel, int channelIndex,
+                                  MaterialTextureSlot slot, bool& needsImport);
+    // Returns 0 if the file can't be read
+    uint64_t hashTextureContent(const std::string& path, bool flipVertical, bool loadOnlyOneChannel, int channelIndex,
+                                MaterialTextureSlot slot);
+    bool getFileHash(const std::string& path, uint64_t& hash);
+    void prefetchTextureHashes(const std::vector<MaterialAsset*>& materialAssets);
     void importTexture(TextureAsset* textureAsset);
+    // All textures have to share the same source file
+    void importTextures(const std::vector<TextureAsset*>& textureAssets, const TextureSizePolicy& sizePolicy);
+    void importTextureAsync(TextureAsset* textureAsset);
+    void importTexturesAsync(const std::vector<TextureAsset*>& textureAssets);
+    static void extractChannels(const unsigned char* pixels, int32_t width, int32_t height, int32_t nrComponents,
+                                const std::vector<TextureAsset*>& textureAssets);
+    void waitForTextureImport(uint32_t textureId);
+    void importEnvironmentMapAsync(EnvironmentMap* environmentMap);
+    // All meshes have to come from the same model
+    void restoreMeshData(const MeshSource& source, const std::vector<MeshAsset*>& meshAssets) const;
+    void waitForMeshLoad(uint32_t meshId);
+    void releaseMeshData(MeshAsset* meshAsset);
+    // Meshes of a model can be shared with other models, their data has to be there before the model gets cached.
+    // Returns false if the data of a mesh could not be restored.
+    bool requireModelMeshData(const std::vector<SubModel>& subModels);
+    // Writes the model to the cache, only then its meshes without a source can be released and restored from it
+    void cacheModel(const std::string& path, ImportProfile importProfile, const Model& model);
+    // Only meshes that belong to the model are registered, meshes that already have a source keep it
+    void registerMeshSources(const std::vector<SubModel>& subModels, const MeshSource& source);
+    void reportDataSize(const std::string& category, uint32_t id, const std::string& name, size_t dataSize);
     void loadDefaultMeshAndTextures();
-    void processNode(const aiNode* node, const aiScene* scene, std::vector<SubModel>& subModels, const std::string& path);
-    MeshAsset* processMesh(aiMesh* mesh, const aiScene* scene, const std::string& path);
-    void processMaterials(const aiScene* scene, SubModel& subModel, const std::string& path, const uint32_t materialIndex);
+    // Creates the assets of a cached or natively imported model and registers it under the path
+    Model* createModel(const std::string& path, ImportProfile importProfile, CachedModel& cachedModel);
+    // Collects the textures of the model for the texture decode time and logs the report
+    void addImportReport(ImportReport&& report, const Model* model);
+    void processNode(const aiNode* node, const aiScene* scene, std::vector<SubModel>& subModels,
+                     ModelImportContext& context);
+    // Takes ownership of the mesh, unless a mesh with the same content exists. Returns the mesh to use.
+    MeshAsset* registerMesh(Scope<MeshAsset>& meshAsset, uint64_t contentHash);
+    static uint64_t hashMeshContent(const std::vector<MeshVertex>& vertices, const std::vector<uint32_t>& indices);
+    // Both meshes need their data
+    static bool isMeshContentEqual(MeshAsset* meshAsset, MeshAsset* otherMeshAsset);
+    // Keyed by mesh id, the replaced meshes may already be removed from the registry
+    void remapMeshes(std::vector<SubModel>& subModels, const std::unordered_map<uint32_t, MeshAsset*>& meshMapping);
+    MeshAsset* prepareMesh(const aiMesh* mesh, uint32_t meshIndex, ModelImportContext& context);
+    MaterialAsset* prepareMaterial(uint32_t materialIndex, ModelImportContext& context);
+    // Tangents the file or Assimp did not provide are only generated if asked to
+    static void processMesh(const aiMesh* mesh, MeshAsset* meshAsset, bool generateTangents);
+    static bool hasNormalTexture(const aiMaterial* aiMaterial);
+    static void processMaterial(const aiMaterial* aiMaterial, const std::string& directory, MaterialAsset* materialAsset);
+    void processCachedNodes(std::vector<CachedNode>& nodes, std::vector<SubModel>& subModels,
+                            const std::vector<MeshAsset*>& meshes, const std::vector<MaterialAsset*>& materials);
+    // Only creates the texture assets, their data is loaded on first use
+    void registerMaterialTextures(MaterialAsset* materialAsset);
+    MeshAsset* findFirstMesh(const std::vector<SubModel>& subModels) const;
+    void watchShaderIncludes(const std::string& shaderPath, const std::string& sourcePath);
+    void reloadShaders(const std::string& path);
+    // Changed meshes are added to m_ChangedMeshes
+    void reloadModel(const std::string& path, ImportProfile importProfile);
 };
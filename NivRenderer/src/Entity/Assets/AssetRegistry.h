@@ -0,0 +1,73 @@
+#pragma once
+#include "Base.h"
+
+// Refers to an asset by id plus the generation of its slot. If the asset gets removed or replaced the generation
+// changes, so an old handle resolves to nullptr instead of a dangling pointer.
+template <typename T>
+struct AssetHandle
+{
+    uint32_t id = UINT32_MAX;
+    uint32_t generation = 0;
+
+    bool IsNull() const { return id == UINT32_MAX; }
+    bool operator==(const AssetHandle& other) const = default;
+};
+
+// Non-owning id -> asset index. Ids come from the IdManager and are dense, so the id is used as the slot index
+// directly and every lookup is a single array access.
+template <typename T>
+class AssetRegistry
+{
+public:
+    AssetHandle<T> Insert(T* asset)
+    {
+        const uint32_t id = asset->GetId();
+        if (id >= m_Slots.size())
+            m_Slots.resize(static_cast<size_t>(id) + 1);
+
+        Slot& slot = m_Slots[id];
+        if (slot.asset != asset)
+        {
+            slot.asset = asset;
+            slot.generation++;
+        }
+
+        return {id, slot.generation};
+    }
+
+    void Remove(const uint32_t id)
+    {
+        if (id >= m_Slots.size() || !m_Slots[id].asset)
+            return;
+
+        m_Slots[id].asset = nullptr;
+        m_Slots[id].generation++;
+    }
+
+    T* Get(const uint32_t id) const { return id < m_Slots.size() ? m_Slots[id].asset : nullptr; }
+
+    T* Get(const AssetHandle<T> handle) const
+    {
+        if (handle.id >= m_Slots.size() || m_Slots[handle.id].generation != handle.generation)
+            return nullptr;
+
+        return m_Slots[handle.id].asset;
+    }
+
+    AssetHandle<T> GetHandle(const uint32_t id) const
+    {
+        if (!Get(id))
+            return {};
+
+        return {id, m_Slots[id].generation};
+    }
+
+private:
+    struct Slot
+    {
+        T* asset = nullptr;
+        uint32_t generation = 0;
+    };
+
+    std::vector<Slot> m_Slots;
+};
@@ -0,0 +1,78 @@
+#include "Entity/Assets/EnvironmentMap.h"
+
+#include <bit>
+
+#include "Application/Util/ImageUtils.h"
+#include "Application/Util/ThreadPool.h"
+#include "glm/gtc/packing.hpp"
+
+EnvironmentMap::EnvironmentMap(const uint32_t id, const std::string& path) :
+    m_Id(id), m_Path(path), m_FaceSize(0), m_IsLoading(false)
+{
+}
+
+void EnvironmentMap::SetData(const int32_t faceSize, PixelBuffer&& data, std::vector<TextureMipLevel>&& mipLevels)
+{
+    m_FaceSize = faceSize;
+    m_Data = std::move(data);
+    m_MipLevels = std::move(mipLevels);
+}
+
+void EnvironmentMap::UnloadData()
+{
+    // The face size and mip levels are kept, they are needed to allocate the GPU texture again
+    m_Data.Reset();
+}
+
+void EnvironmentMap::ConvertEquirectangular(const float* pixels, const int32_t width, const int32_t height)
+{
+    const int32_t faceSize =
+        std::clamp(static_cast<int32_t>(std::bit_floor(static_cast<uint32_t>(std::max(width / 4, 1)))), MIN_FACE_SIZE,
+                   MAX_FACE_SIZE);
+    const size_t faceTexels = static_cast<size_t>(faceSize) * faceSize;
+
+    // Rows are cheap on their own, so every task converts a block of them
+    constexpr int32_t ROWS_PER_TASK = 32;
+    const int32_t blocksPerFace = (faceSize + ROWS_PER_TASK - 1) / ROWS_PER_TASK;
+    std::vector<float> level(faceTexels * 6 * 3);
+    ThreadPool::GetInstance().ParallelFor(static_cast<size_t>(blocksPerFace) * 6, [&](const size_t i) {
+        const auto face = static_cast<int32_t>(i / blocksPerFace);
+        const int32_t firstRow = static_cast<int32_t>(i % blocksPerFace) * ROWS_PER_TASK;
+        ImageUtils::EquirectangularToCubeFace(pixels, width, height, face, faceSize, firstRow,
+                                              std::min(firstRow + ROWS_PER_TASK, faceSize),
+                                              level.data() + faceTexels * 3 * face);
+    });
+
+    size_t totalSize = 0;
+    for (int32_t size = faceSize; size >= 1; size /= 2)
+        totalSize += static_cast<size_t>(size) * size * 6 * 3 * sizeof(uint16_t);
+
+    PixelBuffer data = PixelBuffer::Allocate(totalSize);
+    std::vector<TextureMipLevel> mipLevels;
+    std::vector<float> nextLevel;
+    size_t offset = 0;
+    for (int32_t size = faceSize;; size /= 2)
+    {
+        const size_t levelTexels = static_cast<size_t>(size) * size * 6;
+        auto levelData = reinterpret_cast<uint16_t*>(data.GetData() + offset);
+        for (size_t j = 0; j < levelTexels * 3; j++)
+            levelData[j] = glm::packHalf1x16(level[j]);
+        mipLevels.push_back({size, size, offset, levelTexels * 3 * sizeof(uint16_t)});
+        offset += levelTexels * 3 * sizeof(uint16_t);
+
+        if (size == 1)
+            break;
+
+        // Faces are filtered on their own, the seams between them are not worth blending for a sky
+        const int32_t nextSize = size / 2;
+        const size_t faceValues = static_cast<size_t>(size) * size * 3;
+        const size_t nextFaceValues = static_cast<size_t>(nextSize) * nextSize * 3;
+        nextLevel.resize(nextFaceValues * 6);
+        for (int32_t face = 0; face < 6; face++)
+            ImageUtils::DownsampleHalf(level.data() + faceValues * face, size, size, 3,
+                                       nextLevel.data() + nextFaceValues * face, nextSize, nextSize);
+        std::swap(level, nextLevel);
+    }
+
+    SetData(faceSize, std::move(data), std::move(mipLevels));
+}
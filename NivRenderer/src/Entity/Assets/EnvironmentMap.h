@@ -0,0 +1,43 @@
+#pragma once
+#include "Base.h"
+#include "Application/Util/PixelBuffer.h"
+#include "Entity/Assets/TextureAsset.h"
+
+#include <atomic>
+
+// Cubemap converted from an equirectangular HDR image. The faces are half float RGB with the full mip chain, stored
+// level by level with the six faces of a level next to each other (+X, -X, +Y, -Y, +Z, -Z), so a level is uploaded
+// with a single call. Offset and size of a mip level cover all six faces.
+class EnvironmentMap
+{
+public:
+    EnvironmentMap(uint32_t id, const std::string& path);
+
+    uint32_t GetId() const { return m_Id; }
+    const std::string& GetPath() const { return m_Path; }
+    int32_t GetFaceSize() const { return m_FaceSize; }
+    const PixelBuffer& GetData() const { return m_Data; }
+    const std::vector<TextureMipLevel>& GetMipLevels() const { return m_MipLevels; }
+    void SetData(int32_t faceSize, PixelBuffer&& data, std::vector<TextureMipLevel>&& mipLevels);
+    bool HasData() const { return !m_Data.IsEmpty(); }
+    void UnloadData();
+    size_t GetDataSize() const { return m_Data.GetSize(); }
+
+    bool IsLoading() const { return m_IsLoading.load(std::memory_order_acquire); }
+    void SetLoading(const bool isLoading) { m_IsLoading.store(isLoading, std::memory_order_release); }
+
+    // Projects the RGB float image onto the cube and builds the mip chain, the rows of all faces are converted in
+    // parallel. Faces are a quarter of the image width, rounded down to a power of two.
+    void ConvertEquirectangular(const float* pixels, int32_t width, int32_t height);
+
+private:
+    static constexpr int32_t MIN_FACE_SIZE = 16;
+    static constexpr int32_t MAX_FACE_SIZE = 2048;
+
+    uint32_t m_Id;
+    std::string m_Path;
+    int32_t m_FaceSize;
+    PixelBuffer m_Data;
+    std::vector<TextureMipLevel> m_MipLevels;
+    std::atomic<bool> m_IsLoading;
+};
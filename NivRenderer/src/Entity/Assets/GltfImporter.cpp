@@ -0,0 +1,658 @@
+#include "Entity/Assets/GltfImporter.h"
+
+#include <cstring>
+#include <filesystem>
+#include <unordered_set>
+
+#include "Application/Util/Instrumentor.h"
+#include "Application/Util/ThreadPool.h"
+#include "Entity/Assets/MeshOptimizer.h"
+#include "glm/gtc/matrix_transform.hpp"
+#include "glm/gtc/quaternion.hpp"
+
+namespace
+{
+    constexpr int32_t COMPONENT_BYTE = 5120;
+    constexpr int32_t COMPONENT_UNSIGNED_BYTE = 5121;
+    constexpr int32_t COMPONENT_SHORT = 5122;
+    constexpr int32_t COMPONENT_UNSIGNED_SHORT = 5123;
+    constexpr int32_t COMPONENT_UNSIGNED_INT = 5125;
+    constexpr int32_t COMPONENT_FLOAT = 5126;
+
+    constexpr int32_t MODE_TRIANGLES = 4;
+    constexpr int32_t MODE_TRIANGLE_STRIP = 5;
+    constexpr int32_t MODE_TRIANGLE_FAN = 6;
+
+    size_t getComponentSize(const int32_t componentType)
+    {
+        switch (componentType)
+        {
+        case COMPONENT_BYTE:
+        case COMPONENT_UNSIGNED_BYTE:
+            return 1;
+        case COMPONENT_SHORT:
+        case COMPONENT_UNSIGNED_SHORT:
+            return 2;
+        case COMPONENT_UNSIGNED_INT:
+        case COMPONENT_FLOAT:
+            return 4;
+        default:
+            return 0;
+        }
+    }
+
+    int32_t getComponentCount(const std::string& type)
+    {
+        if (type == "SCALAR")
+            return 1;
+        if (type == "VEC2")
+            return 2;
+        if (type == "VEC3")
+            return 3;
+        if (type == "VEC4" || type == "MAT2")
+            return 4;
+        if (type == "MAT3")
+            return 9;
+        if (type == "MAT4")
+            return 16;
+        return 0;
+    }
+
+    template <typename T>
+    T readUnaligned(const unsigned char* data)
+    {
+        T value;
+        memcpy(&value, data, sizeof(T));
+        return value;
+    }
+
+    bool endsWith(const std::string& string, const std::string& ending)
+    {
+        if (string.size() < ending.size())
+            return false;
+        return std::equal(ending.rbegin(), ending.rend(), string.rbegin(),
+                          [](const char a, const char b) { return a == std::tolower(static_cast<unsigned char>(b)); });
+    }
+}
+
+bool GltfImporter::CanImport(const std::string& path)
+{
+    return endsWith(path, ".gltf") || endsWith(path, ".glb");
+}
+
+bool GltfImporter::Import(const std::string& path, const ImportProfile profile, CachedModel& outModel,
+                          ImportReport& report)
+{
+    PROFILE_SCOPE("GltfImporter::Import")
+
+    m_Path = path;
+    m_Directory = path.substr(0, path.find_last_of('/'));
+    m_Settings = &ImportSettings::Get(profile);
+    m_GlbBinaryChunk = {nullptr, 0};
+    auto phaseStart = std::chrono::steady_clock::now();
+    if (!parseDocument() || !loadBuffers())
+        return false;
+    report.parseTime = ImportReport::GetElapsedTime(phaseStart);
+
+    try
+    {
+        outModel.name = std::filesystem::path(path).stem().string();
+
+        // Every primitive becomes its own mesh, the same way Assimp splits them
+        std::vector<PrimitiveReference> primitives;
+        std::unordered_set<std::string> meshPaths;
+        const nlohmann::json& meshes = m_Document.contains("meshes") ? m_Document["meshes"] : nlohmann::json::array();
+        m_MeshPrimitives.resize(meshes.size());
+        for (uint32_t meshIndex = 0; meshIndex < meshes.size(); meshIndex++)
+        {
+            const nlohmann::json& mesh = meshes[meshIndex];
+            const std::string meshName = mesh.value("name", "Mesh" + std::to_string(meshIndex));
+            for (const nlohmann::json& primitive : mesh.at("primitives"))
+            {
+                const auto primitiveIndex = static_cast<int32_t>(primitives.size());
+                std::string meshPath = path + '@' + meshName;
+                if (meshPaths.contains(meshPath))
+                    meshPath += '#' + std::to_string(primitiveIndex);
+                meshPaths.insert(meshPath);
+
+                CachedMesh cachedMesh;
+                cachedMesh.path = meshPath;
+                outModel.meshes.push_back(std::move(cachedMesh));
+                m_MeshPrimitives[meshIndex].push_back(primitiveIndex);
+                m_PrimitiveMaterials.push_back(primitive.value("material", -1));
+                primitives.push_back({&primitive, meshIndex});
+            }
+        }
+
+        // Accessors are read straight from the mapped buffers, so the conversion can run on all cores
+        phaseStart = std::chrono::steady_clock::now();
+        std::vector<uint8_t> converted(primitives.size(), 0);
+        ThreadPool::GetInstance().ParallelFor(primitives.size(), [this, &primitives, &converted, &outModel](const size_t i) {
+            converted[i] = convertPrimitive(*primitives[i].primitive, outModel.meshes[i]);
+        });
+        for (size_t i = 0; i < converted.size(); i++)
+        {
+            if (!converted[i])
+            {
+                SPDLOG_DEBUG("Could not convert primitive of mesh " + outModel.meshes[i].path);
+                return false;
+            }
+        }
+        report.conversionTime = ImportReport::GetElapsedTime(phaseStart);
+
+        phaseStart = std::chrono::steady_clock::now();
+        ThreadPool::GetInstance().ParallelFor(outModel.meshes.size(), [this, &outModel](const size_t i) {
+            CachedMesh& mesh = outModel.meshes[i];
+            if (m_Settings->optimizeMeshes)
+                MeshOptimizer::OptimizeMesh(mesh.path, mesh.vertices, mesh.indices);
+            if (m_Settings->generateLods)
+                MeshOptimizer::GenerateLods(mesh.path, mesh.vertices, mesh.indices, mesh.lods);
+            MeshOptimizer::BuildMeshlets(mesh.vertices, mesh.indices, mesh.meshlets);
+        });
+        report.optimizationTime = ImportReport::GetElapsedTime(phaseStart);
+
+        convertMaterials(outModel);
+        const auto materialCount = static_cast<int32_t>(outModel.materials.size());
+        bool needsDefaultMaterial = false;
+        for (auto& materialIndex : m_PrimitiveMaterials)
+        {
+            if (materialIndex < 0 || materialIndex >= materialCount)
+            {
+                materialIndex = materialCount;
+                needsDefaultMaterial = true;
+            }
+        }
+        if (needsDefaultMaterial)
+        {
+            CachedMaterial defaultMaterial;
+            defaultMaterial.name = path + '@' + std::to_string(materialCount);
+            outModel.materials.push_back(std::move(defaultMaterial));
+        }
+
+        CachedNode rootNode;
+        rootNode.name = outModel.name;
+        std::vector<int32_t> rootNodeIndices;
+        const int32_t sceneIndex = m_Document.value("scene", 0);
+        if (m_Document.contains("scenes") && sceneIndex < static_cast<int32_t>(m_Document["scenes"].size()))
+        {
+            const nlohmann::json& scene = m_Document["scenes"][sceneIndex];
+            rootNode.name = scene.value("name", rootNode.name);
+            for (const nlohmann::json& nodeIndex : scene.value("nodes", nlohmann::json::array()))
+                rootNodeIndices.push_back(nodeIndex);
+        }
+        else if (m_Document.contains("nodes"))
+        {
+            // Without a scene, every node that is not a child of another node is a root
+            const nlohmann::json& nodes = m_Document["nodes"];
+            std::vector<uint8_t> isChild(nodes.size(), 0);
+            for (const nlohmann::json& node : nodes)
+            {
+                for (const nlohmann::json& childIndex : node.value("children", nlohmann::json::array()))
+                {
+                    if (childIndex < nodes.size())
+                        isChild[childIndex.get<size_t>()] = 1;
+                }
+            }
+            for (size_t i = 0; i < nodes.size(); i++)
+            {
+                if (!isChild[i])
+                    rootNodeIndices.push_back(static_cast<int32_t>(i));
+            }
+        }
+        for (const int32_t nodeIndex : rootNodeIndices)
+            convertNode(nodeIndex, rootNode.children, 0);
+        outModel.nodes.push_back(std::move(rootNode));
+    }
+    catch (const nlohmann::json::exception& exception)
+    {
+        SPDLOG_DEBUG("Invalid glTF file " + path + ": " + exception.what());
+        return false;
+    }
+
+    return true;
+}
+
+bool GltfImporter::parseDocument()
+{
+    MappedFile file;
+    if (!file.Open(m_Path))
+    {
+        SPDLOG_DEBUG("Could not open glTF file " + m_Path);
+        return false;
+    }
+
+    const unsigned char* data = file.GetData();
+    const size_t size = file.GetSize();
+    if (size >= 12 && readUnaligned<uint32_t>(data) == GLB_MAGIC)
+    {
+        // Binary glTF: 12 byte header, JSON chunk, optional binary chunk
+        size_t offset = 12;
+        const unsigned char* jsonData = nullptr;
+        size_t jsonSize = 0;
+        while (offset + 8 <= size)
+        {
+            const auto chunkSize = readUnaligned<uint32_t>(data + offset);
+            const auto chunkType = readUnaligned<uint32_t>(data + offset + 4);
+            offset += 8;
+            if (chunkSize > size - offset)
+                break;
+
+            if (chunkType == GLB_CHUNK_JSON && !jsonData)
+            {
+                jsonData = data + offset;
+                jsonSize = chunkSize;
+            }
+            else if (chunkType == GLB_CHUNK_BIN && !m_GlbBinaryChunk.data)
+                m_GlbBinaryChunk = {data + offset, chunkSize};
+            offset += chunkSize;
+        }
+        if (!jsonData)
+        {
+            SPDLOG_DEBUG("glTF binary file without JSON chunk " + m_Path);
+            return false;
+        }
+        m_Document = nlohmann::json::parse(jsonData, jsonData + jsonSize, nullptr, false);
+    }
+    else
+        m_Document = nlohmann::json::parse(data, data + size, nullptr, false);
+
+    if (m_Document.is_discarded() || !m_Document.is_object())
+    {
+        SPDLOG_DEBUG("Could not parse glTF file " + m_Path);
+        return false;
+    }
+    const std::string version = m_Document.contains("asset") ? m_Document["asset"].value("version", "") : "";
+    if (version.empty() || version[0] != '2')
+    {
+        SPDLOG_DEBUG("Unsupported glTF version in " + m_Path);
+        return false;
+    }
+
+    // The binary chunk points into the mapping, so it has to stay alive
+    m_MappedFiles.push_back(std::move(file));
+    return true;
+}
+
+bool GltfImporter::loadBuffers()
+{
+    if (!m_Document.contains("buffers"))
+        return true;
+
+    for (const nlohmann::json& buffer : m_Document["buffers"])
+    {
+        const size_t byteLength = buffer.value("byteLength", static_cast<size_t>(0));
+        if (!buffer.contains("uri"))
+        {
+            if (!m_GlbBinaryChunk.data || m_GlbBinaryChunk.size < byteLength)
+            {
+                SPDLOG_DEBUG("glTF buffer without data in " + m_Path);
+                return false;
+            }
+            m_Buffers.push_back(m_GlbBinaryChunk);
+            continue;
+        }
+
+        const std::string uri = buffer["uri"];
+        if (uri.starts_with("data:"))
+        {
+            SPDLOG_DEBUG("Embedded glTF buffers are not supported: " + m_Path);
+            return false;
+        }
+
+        MappedFile bufferFile;
+        if (!bufferFile.Open(m_Directory + '/' + decodeUri(uri)) || bufferFile.GetSize() < byteLength)
+        {
+            SPDLOG_DEBUG("Could not open glTF buffer " + uri);
+            return false;
+        }
+        m_Buffers.push_back({bufferFile.GetData(), byteLength});
+        m_MappedFiles.push_back(std::move(bufferFile));
+    }
+
+    return true;
+}
+
+bool GltfImporter::getAccessor(const int32_t accessorIndex, AccessorView& view) const
+{
+    const nlohmann::json& accessors = m_Document.at("accessors");
+    if (accessorIndex < 0 || accessorIndex >= static_cast<int32_t>(accessors.size()))
+        return false;
+
+    const nlohmann::json& accessor = accessors[accessorIndex];
+    if (accessor.contains("sparse") || !accessor.contains("bufferView"))
+        return false;
+
+    view.componentType = accessor.at("componentType");
+    view.componentCount = getComponentCount(accessor.at("type"));
+    view.count = accessor.at("count");
+    view.normalized = accessor.value("normalized", false);
+    const size_t elementSize = getComponentSize(view.componentType) * view.componentCount;
+    if (elementSize == 0)
+        return false;
+
+    const int32_t bufferViewIndex = accessor["bufferView"];
+    const nlohmann::json& bufferViews = m_Document.at("bufferViews");
+    if (bufferViewIndex < 0 || bufferViewIndex >= static_cast<int32_t>(bufferViews.size()))
+        return false;
+    const nlohmann::json& bufferView = bufferViews[bufferViewIndex];
+    const int32_t bufferIndex = bufferView.at("buffer");
+    if (bufferIndex < 0 || bufferIndex >= static_cast<int32_t>(m_Buffers.size()))
+        return false;
+
+    const BufferData& buffer = m_Buffers[bufferIndex];
+    const size_t viewOffset = bufferView.value("byteOffset", static_cast<size_t>(0));
+    const size_t viewLength = bufferView.at("byteLength");
+    const size_t accessorOffset = accessor.value("byteOffset", static_cast<size_t>(0));
+    view.stride = bufferView.value("byteStride", static_cast<size_t>(0));
+    if (view.stride == 0)
+        view.stride = elementSize;
+
+    // Written without sums of untrusted values, so huge offsets or counts can't wrap around and pass
+    if (viewOffset > buffer.size || viewLength > buffer.size - viewOffset)
+        return false;
+    if (view.count > 0 && (accessorOffset > viewLength || elementSize > viewLength - accessorOffset ||
+                           view.count - 1 > (viewLength - accessorOffset - elementSize) / view.stride))
+        return false;
+
+    view.data = buffer.data + viewOffset + accessorOffset;
+    return true;
+}
+
+float GltfImporter::readComponent(const AccessorView& view, const size_t element, const int32_t component)
+{
+    const unsigned char* data = view.data + element * view.stride + component * getComponentSize(view.componentType);
+    switch (view.componentType)
+    {
+    case COMPONENT_FLOAT:
+        return readUnaligned<float>(data);
+    case COMPONENT_UNSIGNED_BYTE:
+        return view.normalized ? static_cast<float>(data[0]) / 255.0f : static_cast<float>(data[0]);
+    case COMPONENT_BYTE: {
+        const auto value = static_cast<float>(static_cast<int8_t>(data[0]));
+        return view.normalized ? std::max(value / 127.0f, -1.0f) : value;
+    }
+    case COMPONENT_UNSIGNED_SHORT: {
+        const auto value = static_cast<float>(readUnaligned<uint16_t>(data));
+        return view.normalized ? value / 65535.0f : value;
+    }
+    case COMPONENT_SHORT: {
+        const auto value = static_cast<float>(readUnaligned<int16_t>(data));
+        return view.normalized ? std::max(value / 32767.0f, -1.0f) : value;
+    }
+    case COMPONENT_UNSIGNED_INT:
+        return static_cast<float>(readUnaligned<uint32_t>(data));
+    default:
+        return 0.0f;
+    }
+}
+
+uint32_t GltfImporter::readIndex(const AccessorView& view, const size_t element)
+{
+    const unsigned char* data = view.data + element * view.stride;
+    switch (view.componentType)
+    {
+    case COMPONENT_UNSIGNED_BYTE:
+        return data[0];
+    case COMPONENT_UNSIGNED_SHORT:
+        return readUnaligned<uint16_t>(data);
+    case COMPONENT_UNSIGNED_INT:
+        return readUnaligned<uint32_t>(data);
+    default:
+        return UINT32_MAX;
+    }
+}
+
+bool GltfImporter::convertPrimitive(const nlohmann::json& primitive, CachedMesh& mesh) const
+{
+    try
+    {
+        const int32_t mode = primitive.value("mode", MODE_TRIANGLES);
+        if (mode != MODE_TRIANGLES && mode != MODE_TRIANGLE_STRIP && mode != MODE_TRIANGLE_FAN)
+            return false;
+
+        const nlohmann::json& attributes = primitive.at("attributes");
+        AccessorView positions;
+        if (!attributes.contains("POSITION") || !getAccessor(attributes["POSITION"], positions) ||
+            positions.componentCount != 3)
+            return false;
+        const size_t vertexCount = positions.count;
+
+        auto getOptionalAccessor = [this, &attributes, vertexCount](const char* name, const int32_t componentCount,
+                                                                   AccessorView& view) {
+            return attributes.contains(name) && getAccessor(attributes[name], view) &&
+                view.componentCount == componentCount && view.count == vertexCount;
+        };
+        AccessorView normals, texCoords, tangents;
+        const bool hasNormals = getOptionalAccessor("NORMAL", 3, normals);
+        const bool hasTexCoords = getOptionalAccessor("TEXCOORD_0", 2, texCoords);
+        const bool hasTangents = hasTexCoords && getOptionalAccessor("TANGENT", 4, tangents);
+
+        auto& vertices = mesh.vertices;
+        vertices.resize(vertexCount);
+        for (size_t i = 0; i < vertexCount; i++)
+        {
+            MeshVertex& vertex = vertices[i];
+            if (positions.componentType == COMPONENT_FLOAT)
+                memcpy(&vertex.Position, positions.data + i * positions.stride, sizeof(glm::vec3));
+            else
+                vertex.Position = {readComponent(positions, i, 0), readComponent(positions, i, 1),
+                                   readComponent(positions, i, 2)};
+
+            vertex.Normal = glm::vec3(0.0f);
+            if (hasNormals)
+                vertex.Normal = {readComponent(normals, i, 0), readComponent(normals, i, 1),
+                                 readComponent(normals, i, 2)};
+
+            // Flipped like aiProcess_FlipUVs does it, so the materials work for both importers
+            vertex.TexCoords = glm::vec2(0.0f);
+            if (hasTexCoords)
+                vertex.TexCoords = {readComponent(texCoords, i, 0), 1.0f - readComponent(texCoords, i, 1)};
+
+            vertex.Tangent = glm::vec3(0.0f);
+            vertex.Bitangent = glm::vec3(0.0f);
+            if (hasTangents)
+            {
+                vertex.Tangent = {readComponent(tangents, i, 0), readComponent(tangents, i, 1),
+                                  readComponent(tangents, i, 2)};
+                vertex.Bitangent = glm::cross(vertex.Normal, vertex.Tangent) * readComponent(tangents, i, 3);
+            }
+        }
+
+        std::vector<uint32_t> primitiveIndices;
+        if (primitive.contains("indices"))
+        {
+            AccessorView indexView;
+            if (!getAccessor(primitive["indices"], indexView) || indexView.componentCount != 1)
+                return false;
+
+            primitiveIndices.resize(indexView.count);
+            for (size_t i = 0; i < indexView.count; i++)
+            {
+                primitiveIndices[i] = readIndex(indexView, i);
+                if (primitiveIndices[i] >= vertexCount)
+                    return false;
+            }
+        }
+        else
+        {
+            primitiveIndices.resize(vertexCount);
+            for (size_t i = 0; i < vertexCount; i++)
+                primitiveIndices[i] = static_cast<uint32_t>(i);
+        }
+
+        auto& indices = mesh.indices;
+        if (mode == MODE_TRIANGLES)
+        {
+            primitiveIndices.resize(primitiveIndices.size() - primitiveIndices.size() % 3);
+            indices = std::move(primitiveIndices);
+        }
+        else if (primitiveIndices.size() >= 3)
+        {
+            indices.reserve((primitiveIndices.size() - 2) * 3);
+            for (size_t i = 0; i + 2 < primitiveIndices.size(); i++)
+            {
+                if (mode == MODE_TRIANGLE_FAN)
+                    indices.insert(indices.end(), {primitiveIndices[0], primitiveIndices[i + 1], primitiveIndices[i + 2]});
+                else if (i % 2 == 0)
+                    indices.insert(indices.end(), {primitiveIndices[i], primitiveIndices[i + 1], primitiveIndices[i + 2]});
+                else
+                    indices.insert(indices.end(), {primitiveIndices[i + 1], primitiveIndices[i], primitiveIndices[i + 2]});
+            }
+        }
+
+        if (!hasNormals)
+            MeshOptimizer::GenerateNormals(vertices, indices);
+        if (hasTexCoords && !hasTangents &&
+            (m_Settings->tangentsForAllMeshes || hasNormalTexture(primitive.value("material", -1))))
+            MeshOptimizer::GenerateTangents(vertices, indices);
+    }
+    catch (const nlohmann::json::exception&)
+    {
+        // Runs on the worker threads, the exception must not escape
+        return false;
+    }
+
+    return true;
+}
+
+bool GltfImporter::hasNormalTexture(const int32_t materialIndex) const
+{
+    if (materialIndex < 0 || !m_Document.contains("materials") || materialIndex >= static_cast<int32_t>(m_Document["materials"].size()))
+        return false;
+
+    return m_Document["materials"][materialIndex].contains("normalTexture");
+}
+
+void GltfImporter::convertMaterials(CachedModel& model) const
+{
+    if (!m_Document.contains("materials"))
+        return;
+
+    const nlohmann::json& materials = m_Document["materials"];
+    const nlohmann::json noPbr = nlohmann::json::object();
+    for (size_t i = 0; i < materials.size(); i++)
+    {
+        const nlohmann::json& material = materials[i];
+        const nlohmann::json& pbr = material.contains("pbrMetallicRoughness") ? material["pbrMetallicRoughness"] : noPbr;
+
+        CachedMaterial cachedMaterial;
+        cachedMaterial.name = m_Path + '@' + std::to_string(i);
+        cachedMaterial.diffusePath = getImagePath(pbr, "baseColorTexture");
+        cachedMaterial.normalPath = getImagePath(material, "normalTexture");
+        // Metallic (blue) and roughness (green) share a texture, the AssetManager splits the channels
+        cachedMaterial.metallicPath = getImagePath(pbr, "metallicRoughnessTexture");
+        cachedMaterial.roughnessPath = cachedMaterial.metallicPath;
+        cachedMaterial.aoPath = getImagePath(material, "occlusionTexture");
+        cachedMaterial.emissivePath = getImagePath(material, "emissiveTexture");
+        model.materials.push_back(std::move(cachedMaterial));
+    }
+}
+
+std::string GltfImporter::getImagePath(const nlohmann::json& material, const char* textureName) const
+{
+    if (!material.contains(textureName) || !m_Document.contains("textures") || !m_Document.contains("images"))
+        return "";
+
+    const size_t textureIndex = material[textureName].at("index");
+    const nlohmann::json& textures = m_Document["textures"];
+    if (textureIndex >= textures.size() || !textures[textureIndex].contains("source"))
+        return "";
+
+    const size_t imageIndex = textures[textureIndex]["source"];
+    const nlohmann::json& images = m_Document["images"];
+    if (imageIndex >= images.size())
+        return "";
+
+    const nlohmann::json& image = images[imageIndex];
+    if (!image.contains("uri") || image["uri"].get<std::string>().starts_with("data:"))
+    {
+        SPDLOG_DEBUG("Embedded glTF images are not supported: " + m_Path);
+        return "";
+    }
+
+    return m_Directory + '/' + decodeUri(image["uri"]);
+}
+
+void GltfImporter::convertNode(const int32_t nodeIndex, std::vector<CachedNode>& nodes, const uint32_t depth) const
+{
+    const nlohmann::json& documentNodes = m_Document.at("nodes");
+    // A valid file has no cycles, the depth limit only protects against broken ones
+    if (nodeIndex < 0 || nodeIndex >= static_cast<int32_t>(documentNodes.size()) || depth > MAX_NODE_DEPTH)
+        return;
+
+    const nlohmann::json& node = documentNodes[nodeIndex];
+    CachedNode cachedNode;
+    cachedNode.name = node.value("name", "Node" + std::to_string(nodeIndex));
+    cachedNode.modelMatrix = getNodeMatrix(node);
+
+    if (node.contains("mesh"))
+    {
+        const int32_t meshIndex = node["mesh"];
+        if (meshIndex >= 0 && meshIndex < static_cast<int32_t>(m_MeshPrimitives.size()))
+        {
+            const std::string meshName = m_Document["meshes"][meshIndex].value("name", "Mesh" + std::to_string(meshIndex));
+            for (const int32_t primitiveIndex : m_MeshPrimitives[meshIndex])
+            {
+                CachedNode meshNode;
+                meshNode.name = meshName;
+                meshNode.meshIndex = primitiveIndex;
+                meshNode.materialIndex = m_PrimitiveMaterials[primitiveIndex];
+                cachedNode.children.push_back(std::move(meshNode));
+            }
+        }
+    }
+
+    for (const nlohmann::json& childIndex : node.value("children", nlohmann::json::array()))
+        convertNode(childIndex, cachedNode.children, depth + 1);
+
+    nodes.push_back(std::move(cachedNode));
+}
+
+glm::mat4 GltfImporter::getNodeMatrix(const nlohmann::json& node)
+{
+    glm::mat4 matrix(1.0f);
+    if (node.contains("matrix") && node["matrix"].size() == 16)
+    {
+        // Column major, same as glm
+        for (int32_t i = 0; i < 16; i++)
+            matrix[i / 4][i % 4] = node["matrix"][i];
+        return matrix;
+    }
+
+    if (node.contains("translation") && node["translation"].size() == 3)
+    {
+        const auto& translation = node["translation"];
+        matrix = glm::translate(matrix, glm::vec3(translation[0], translation[1], translation[2]));
+    }
+    if (node.contains("rotation") && node["rotation"].size() == 4)
+    {
+        const auto& rotation = node["rotation"];
+        matrix *= glm::mat4_cast(glm::quat(rotation[3], rotation[0], rotation[1], rotation[2]));
+    }
+    if (node.contains("scale") && node["scale"].size() == 3)
+    {
+        const auto& scale = node["scale"];
+        matrix = glm::scale(matrix, glm::vec3(scale[0], scale[1], scale[2]));
+    }
+
+    return matrix;
+}
+
+std::string GltfImporter::decodeUri(const std::string& uri)
+{
+    std::string decoded;
+    decoded.reserve(uri.size());
+    for (size_t i = 0; i < uri.size(); i++)
+    {
+        if (uri[i] == '%' && i + 2 < uri.size() && std::isxdigit(static_cast<unsigned char>(uri[i + 1])) &&
+            std::isxdigit(static_cast<unsigned char>(uri[i + 2])))
+        {
+            decoded += static_cast<char>(std::stoi(uri.substr(i + 1, 2), nullptr, 16));
+            i += 2;
+        }
+        else
+            decoded += uri[i];
+    }
+
+    return decoded;
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include "Base.h"
+#include "Application/Util/MappedFile.h"
+#include "Entity/Assets/ImportProfile.h"
+#include "Entity/Assets/ModelCache.h"
+#include "json.hpp"
+
+// Imports glTF 2.0 files (.gltf + .bin or .glb) straight into a CachedModel, without going through Assimp.
+// Buffers are memory mapped and accessors are read directly into the vertex/index data. The output matches
+// what the Assimp import produces (flipped UVs, generated normals/tangents), so both can be used interchangeably.
+// Import fails for features it does not handle (e.g. sparse accessors, embedded buffers, non triangle
+// primitives), LoadModel falls back to Assimp in that case.
+class GltfImporter
+{
+public:
+    static bool CanImport(const std::string& path);
+
+    // Fills in the parse, conversion and optimization phases of the report
+    bool Import(const std::string& path, ImportProfile profile, CachedModel& outModel, ImportReport& report);
+
+private:
+    struct BufferData
+    {
+        const unsigned char* data;
+        size_t size;
+    };
+
+    struct AccessorView
+    {
+        const unsigned char* data;
+        size_t count;
+        size_t stride;
+        int32_t componentType;
+        int32_t componentCount;
+        bool normalized;
+    };
+
+    struct PrimitiveReference
+    {
+        const nlohmann::json* primitive;
+        uint32_t meshIndex;
+    };
+
+    static constexpr uint32_t GLB_MAGIC = 0x46546C67; // "glTF"
+    static constexpr uint32_t GLB_CHUNK_JSON = 0x4E4F534A;
+    static constexpr uint32_t GLB_CHUNK_BIN = 0x004E4942;
+    static constexpr uint32_t MAX_NODE_DEPTH = 256;
+
+    std::string m_Path;
+    const ImportSettings* m_Settings = nullptr;
+    std::string m_Directory;
+    nlohmann::json m_Document;
+    std::vector<MappedFile> m_MappedFiles;
+    std::vector<BufferData> m_Buffers;
+    BufferData m_GlbBinaryChunk;
+    // Every glTF mesh becomes one mesh per primitive
+    std::vector<std::vector<int32_t>> m_MeshPrimitives;
+    std::vector<int32_t> m_PrimitiveMaterials;
+
+    bool parseDocument();
+    bool loadBuffers();
+    bool getAccessor(int32_t accessorIndex, AccessorView& view) const;
+    static float readComponent(const AccessorView& view, size_t element, int32_t component);
+    static uint32_t readIndex(const AccessorView& view, size_t element);
+    bool convertPrimitive(const nlohmann::json& primitive, CachedMesh& mesh) const;
+    bool hasNormalTexture(int32_t materialIndex) const;
+    void convertMaterials(CachedModel& model) const;
+    std::string getImagePath(const nlohmann::json& material, const char* textureName) const;
+    void convertNode(int32_t nodeIndex, std::vector<CachedNode>& nodes, uint32_t depth) const;
+    static glm::mat4 getNodeMatrix(const nlohmann::json& node);
+    static std::string decodeUri(const std::string& uri);
+};
@@ -0,0 +1,77 @@
+#pragma once
+#include "Base.h"
+#include "assimp/postprocess.h"
+
+#include <chrono>
+
+// How much work a model import does. The profile a model was imported with is stored with it and is part of the
+// model cache key, so switching it re-imports the model.
+enum class ImportProfile : uint32_t
+{
+    // Everything, for final assets
+    FULL_QUALITY = 0,
+    // Only what is needed to show the model: no mesh optimization or LODs, tangents only where a normal map uses them
+    FAST_PREVIEW = 1,
+    // For files that were optimized by an export pipeline (e.g. gltfpack), which is trusted as is
+    OPTIMIZED_GLTF = 2
+};
+
+struct ImportSettings
+{
+    const char* name;
+    // Only used for formats that go through Assimp
+    uint32_t postProcessFlags;
+    // Otherwise tangents are only generated for meshes whose material has a normal map
+    bool tangentsForAllMeshes;
+    // Vertex cache, overdraw and vertex fetch optimization
+    bool optimizeMeshes;
+    bool generateLods;
+
+    static const ImportSettings& Get(const ImportProfile profile)
+    {
+        static constexpr uint32_t BASE_FLAGS = aiProcess_FlipUVs | aiProcess_Triangulate | aiProcess_SortByPType;
+        // Generating normals is skipped by Assimp for meshes that already have them
+        static const ImportSettings settings[] = {
+            {"Full Quality",
+             BASE_FLAGS | aiProcess_OptimizeMeshes | aiProcess_CalcTangentSpace | aiProcess_GenSmoothNormals |
+                 aiProcess_JoinIdenticalVertices | aiProcess_GenUVCoords | aiProcess_RemoveRedundantMaterials |
+                 aiProcess_FixInfacingNormals,
+             true, true, true},
+            {"Fast Preview", BASE_FLAGS | aiProcess_GenNormals | aiProcess_JoinIdenticalVertices, false, false, false},
+            {"Optimized glTF", BASE_FLAGS | aiProcess_GenSmoothNormals, false, false, true}
+        };
+
+        const auto index = static_cast<size_t>(profile);
+        return index < std::size(settings) ? settings[index] : settings[0];
+    }
+};
+
+// Wall clock time of every phase of a model import in microseconds, phases that did not run stay 0
+struct ImportReport
+{
+    ImportReport(const std::string& path, const ImportProfile profile) :
+        path(path), profile(profile), fromCache(false), parseTime(0), postProcessTime(0), conversionTime(0),
+        optimizationTime(0), textureDecodeTime(0)
+    {
+    }
+
+    std::string path;
+    ImportProfile profile;
+    bool fromCache;
+    // Reading the file, or the model cache entry
+    int64_t parseTime;
+    // Assimp post-processing steps
+    int64_t postProcessTime;
+    // Into vertices, indices and materials, including generated normals and tangents
+    int64_t conversionTime;
+    // Mesh optimization, LODs and meshlets
+    int64_t optimizationTime;
+    // Textures are decoded on first use, so this grows as the textures of the model get loaded
+    int64_t textureDecodeTime;
+    std::vector<uint32_t> textureIds;
+
+    static int64_t GetElapsedTime(const std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+};
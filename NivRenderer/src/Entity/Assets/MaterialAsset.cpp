@@ -17,7 +17,8 @@ void MaterialAsset::reloadDiffuseTexture()
     if (m_DiffusePath.empty())
         return;
 
-    m_DiffuseTextureAsset = AssetManager::GetInstance().LoadTexture(m_DiffusePath, m_FlipDiffuseTexture);
+    m_DiffuseTextureAsset = AssetManager::GetInstance().LoadTextureAsync(m_DiffusePath, m_FlipDiffuseTexture, false, 0,
+                                                                      MaterialTextureSlot::DIFFUSE);
     m_DirtyFlag = true;
 }
 
@@ -26,7 +27,8 @@ void MaterialAsset::reloadNormalTexture()
     if (m_NormalPath.empty())
         return;
 
-    m_NormalTextureAsset = AssetManager::GetInstance().LoadTexture(m_NormalPath, m_FlipNormalTexture);
+    m_NormalTextureAsset = AssetManager::GetInstance().LoadTextureAsync(m_NormalPath, m_FlipNormalTexture, false, 0,
+                                                                      MaterialTextureSlot::NORMAL);
     m_DirtyFlag = true;
 }
 
@@ -35,7 +37,8 @@ void MaterialAsset::reloadMetallicTexture()
     if (m_MetallicPath.empty())
         return;
 
-    m_MetallicTextureAsset = AssetManager::GetInstance().LoadTexture(m_MetallicPath, m_FlipMetallicTexture);
+    m_MetallicTextureAsset = AssetManager::GetInstance().LoadTextureAsync(m_MetallicPath, m_FlipMetallicTexture, false, 0,
+                                                                      MaterialTextureSlot::METALLIC);
     m_DirtyFlag = true;
 }
 
@@ -44,7 +47,8 @@ void MaterialAsset::reloadRoughnessTexture()
     if (m_RoughnessPath.empty())
         return;
 
-    m_RoughnessTextureAsset = AssetManager::GetInstance().LoadTexture(m_RoughnessPath, m_FlipRoughnessTexture);
+    m_RoughnessTextureAsset = AssetManager::GetInstance().LoadTextureAsync(m_RoughnessPath, m_FlipRoughnessTexture, false, 0,
+                                                                      MaterialTextureSlot::ROUGHNESS);
     m_DirtyFlag = true;
 }
 
@@ -53,7 +57,8 @@ void MaterialAsset::reloadAOTexture()
     if (m_AOPath.empty())
         return;
 
-    m_AOTextureAsset = AssetManager::GetInstance().LoadTexture(m_AOPath, m_FlipAOTexture);
+    m_AOTextureAsset = AssetManager::GetInstance().LoadTextureAsync(m_AOPath, m_FlipAOTexture, false, 0,
+                                                                      MaterialTextureSlot::AO);
     m_DirtyFlag = true;
 }
 
@@ -62,7 +67,8 @@ void MaterialAsset::reloadEmissiveTexture()
     if (m_EmissivePath.empty())
         return;
 
-    m_EmissiveTextureAsset = AssetManager::GetInstance().LoadTexture(m_EmissivePath, m_FlipEmissiveTexture);
+    m_EmissiveTextureAsset = AssetManager::GetInstance().LoadTextureAsync(m_EmissivePath, m_FlipEmissiveTexture, false, 0,
+                                                                      MaterialTextureSlot::EMISSIVE);
     m_DirtyFlag = true;
 }
 
@@ -70,7 +76,7 @@ std::vector<std::pair<std::string, Property>> MaterialAsset::GetAssetProperties(
 {
     std::vector<std::pair<std::string, Property>> returnVector;
 
-    returnVector.push_back({"Name", {PropertyType::STRING, &m_Name, [](){}}});
+    returnVector.push_back({"Name", {PropertyType::STRING, &m_Name, [this]() { AssetManager::GetInstance().UpdateMaterialName(m_Id); }}});
 
     returnVector.push_back({"Diffuse", {PropertyType::SEPARATORTEXT, nullptr, [this]() {}}});
     returnVector.push_back({"Diffuse Path", {PropertyType::PATH, &m_DiffusePath, [this]() { reloadDiffuseTexture(); }}});
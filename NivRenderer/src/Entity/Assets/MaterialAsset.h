@@ -34,6 +34,12 @@ public:
     bool& GetFlipAOTexture() { return m_FlipAOTexture; }
     bool& GetFlipEmissiveTexture() { return m_FlipEmissiveTexture; }
 
+    // Color slots are authored in sRGB and get decoded by the GPU, all other slots hold linear data
+    static bool IsSRGBSlot(const MaterialTextureSlot slot)
+    {
+        return slot == MaterialTextureSlot::DIFFUSE || slot == MaterialTextureSlot::EMISSIVE;
+    }
+
     std::vector<std::pair<std::string, Property>> GetAssetProperties();
 
     nlohmann::ordered_json SerializeObject();
@@ -1,5 +1,7 @@
 #include "Entity/Assets/MeshAsset.h"
 
+#include "Entity/Assets/MeshOptimizer.h"
+
 uint32_t MeshAsset::GetId() const
 {
     return m_Id;
@@ -20,11 +22,53 @@ std::vector<uint32_t>& MeshAsset::GetIndices()
     return m_Indices;
 }
 
+std::vector<MeshLod>& MeshAsset::GetLods()
+{
+    return m_Lods;
+}
+
+std::vector<Meshlet>& MeshAsset::GetMeshlets()
+{
+    return m_Meshlets;
+}
+
+void MeshAsset::ReleaseData()
+{
+    m_VertexCount = m_Vertices.size();
+    m_IndexCount = m_Indices.size();
+    m_Vertices = {};
+    m_Indices = {};
+    m_Lods = {};
+    m_Meshlets = {};
+    m_IsDataReleased.store(true, std::memory_order_release);
+}
+
+void MeshAsset::RestoreData(std::vector<MeshVertex>&& vertices, std::vector<uint32_t>&& indices,
+                            std::vector<MeshLod>&& lods, std::vector<Meshlet>&& meshlets)
+{
+    m_Vertices = std::move(vertices);
+    m_Indices = std::move(indices);
+    m_Lods = std::move(lods);
+    m_Meshlets = std::move(meshlets);
+    m_IsDataReleased.store(false, std::memory_order_release);
+}
+
+size_t MeshAsset::GetDataSize() const
+{
+    size_t dataSize = m_Vertices.size() * sizeof(MeshVertex) + m_Indices.size() * sizeof(uint32_t) +
+        m_Meshlets.size() * sizeof(Meshlet);
+    for (const auto& lod : m_Lods)
+        dataSize += lod.indices.size() * sizeof(uint32_t);
+
+    return dataSize;
+}
+
 nlohmann::ordered_json MeshAsset::SerializeObject()
 {
     nlohmann::ordered_json mesh = {
         {"Id", GetId()},
         {"InternalPath", m_Path},
+        {"VertexFormat", static_cast<uint32_t>(m_VertexFormat)},
     };
 
     mesh["Vertices"] = nlohmann::json::array();
@@ -43,15 +87,27 @@ nlohmann::ordered_json MeshAsset::SerializeObject()
 
     mesh["Indices"] = m_Indices;
 
+    mesh["Lods"] = nlohmann::json::array();
+    for (const auto& lod : m_Lods)
+        mesh["Lods"].push_back({{"Error", lod.error}, {"Indices", lod.indices}});
+
     return mesh;
 }
 
 void MeshAsset::DeSerializeObject(nlohmann::json jsonObject)
 {
+    if (jsonObject.contains("VertexFormat"))
+        m_VertexFormat = static_cast<MeshVertexFormat>(jsonObject["VertexFormat"].get<uint32_t>());
     {
         const std::vector<uint32_t> indices = jsonObject["Indices"];
         m_Indices = indices;
     }
+    m_Lods.clear();
+    if (jsonObject.contains("Lods"))
+    {
+        for (const nlohmann::json& lod : jsonObject["Lods"])
+            m_Lods.push_back({lod["Indices"].get<std::vector<uint32_t>>(), lod["Error"].get<float>()});
+    }
     for (nlohmann::json vertex : jsonObject["Vertices"])
     {
         MeshVertex vert;
@@ -63,4 +119,7 @@ void MeshAsset::DeSerializeObject(nlohmann::json jsonObject)
 
         m_Vertices.push_back(vert);
     }
+
+    // Cheap to build, so they are not stored in the scene file
+    MeshOptimizer::BuildMeshlets(m_Vertices, m_Indices, m_Meshlets);
 }
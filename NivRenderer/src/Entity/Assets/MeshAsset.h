@@ -3,28 +3,100 @@
 #include "Entity/PropertyType.h"
 #include "json.hpp"
 
+#include <atomic>
+
+// Zero initialized, attributes a source doesn't provide must not leave garbage in the cache and its content hash
 struct MeshVertex
 {
-    glm::vec3 Position;
-    glm::vec3 Normal;
-    glm::vec2 TexCoords;
-    glm::vec3 Tangent;
-    glm::vec3 Bitangent;
+    glm::vec3 Position{0.0f};
+    glm::vec3 Normal{0.0f};
+    glm::vec2 TexCoords{0.0f};
+    glm::vec3 Tangent{0.0f};
+    glm::vec3 Bitangent{0.0f};
+};
+
+// Layout the vertices are uploaded to the GPU with. PACKED quantizes positions to 16 bit relative to the mesh
+// bounds, stores normal and tangent octahedral encoded (the bitangent is rebuilt from them and a sign) and
+// uses half float UVs, which makes a vertex 20 instead of 56 bytes.
+enum class MeshVertexFormat : uint32_t
+{
+    FULL = 0,
+    PACKED = 1
+};
+
+struct PackedMeshVertex
+{
+    uint16_t Position[3];
+    uint16_t BitangentSign;
+    int16_t NormalTangent[4];
+    uint16_t TexCoords[2];
+};
+
+// Coarser level of detail, indexes the vertices of LOD 0
+struct MeshLod
+{
+    std::vector<uint32_t> indices;
+    // Largest RMS distance of a collapsed vertex to the planes of its original triangles (the square root of its
+    // quadric error), summed over the levels before, in object space. An estimate of how far the surface moved, not a
+    // bound.
+    float error;
+};
+
+// Cluster of at most 64 vertices and 124 triangles, covering a contiguous range of the LOD 0 indices so it can be
+// drawn on its own. Laid out with vec4 alignment, so the array can be uploaded as a std430 buffer unchanged.
+struct Meshlet
+{
+    glm::vec3 Center;
+    float Radius;
+    // Backfacing from every point where dot(center - viewPosition, ConeAxis) >= ConeCutoff * distance + Radius
+    glm::vec3 ConeAxis;
+    float ConeCutoff;
+    uint32_t FirstIndex;
+    uint32_t IndexCount;
+    uint32_t VertexCount;
+    uint32_t Padding;
 };
 
 class MeshAsset
 {
 public:
     MeshAsset(const uint32_t id, const std::string& path, const std::vector<MeshVertex>& vertices, const std::vector<uint32_t>& indices) :
-        m_Id(id), m_Path(path), m_Vertices(vertices), m_Indices(indices)
+        m_Id(id), m_Path(path), m_Vertices(vertices), m_Indices(indices), m_VertexFormat(MeshVertexFormat::PACKED),
+        m_IsDataReleased(false), m_VertexCount(0), m_IndexCount(0), m_IsLoading(false)
+    {}
+    MeshAsset(const uint32_t id, const std::string& path, std::vector<MeshVertex>&& vertices, std::vector<uint32_t>&& indices) :
+        m_Id(id), m_Path(path), m_Vertices(std::move(vertices)), m_Indices(std::move(indices)),
+        m_VertexFormat(MeshVertexFormat::PACKED), m_IsDataReleased(false), m_VertexCount(0), m_IndexCount(0),
+        m_IsLoading(false)
     {}
-    MeshAsset(const uint32_t id, const std::string& path) : m_Id(id), m_Path(path)
+    MeshAsset(const uint32_t id, const std::string& path) :
+        m_Id(id), m_Path(path), m_VertexFormat(MeshVertexFormat::PACKED), m_IsDataReleased(false), m_VertexCount(0),
+        m_IndexCount(0), m_IsLoading(false)
     {}
 
     uint32_t GetId() const;
     const std::string& GetPath();
     std::vector<MeshVertex>& GetVertices();
     std::vector<uint32_t>& GetIndices();
+    std::vector<MeshLod>& GetLods();
+    // Empty for meshes that are small enough to be culled as a whole
+    std::vector<Meshlet>& GetMeshlets();
+    MeshVertexFormat GetVertexFormat() const { return m_VertexFormat; }
+    // Only applies to mesh proxies created afterwards
+    void SetVertexFormat(const MeshVertexFormat vertexFormat) { m_VertexFormat = vertexFormat; }
+
+    // The geometry can be released once it is on the GPU, the counts stay valid so meshes can still be compared.
+    // RestoreData runs on a worker thread, the flag is only cleared once the data is complete.
+    bool IsDataReleased() const { return m_IsDataReleased.load(std::memory_order_acquire); }
+    void ReleaseData();
+    void RestoreData(std::vector<MeshVertex>&& vertices, std::vector<uint32_t>&& indices, std::vector<MeshLod>&& lods,
+                     std::vector<Meshlet>&& meshlets);
+    size_t GetVertexCount() const { return IsDataReleased() ? m_VertexCount : m_Vertices.size(); }
+    size_t GetIndexCount() const { return IsDataReleased() ? m_IndexCount : m_Indices.size(); }
+    // Bytes of geometry held on the CPU
+    size_t GetDataSize() const;
+    bool IsLoading() const { return m_IsLoading.load(std::memory_order_acquire); }
+    void SetLoading(const bool isLoading) { m_IsLoading.store(isLoading, std::memory_order_release); }
 
     std::vector<std::pair<std::string, Property>> GetAssetProperties()
     {
@@ -40,4 +112,11 @@ private:
     std::string m_Path;
     std::vector<MeshVertex> m_Vertices;
     std::vector<uint32_t> m_Indices;
+    std::vector<MeshLod> m_Lods;
+    std::vector<Meshlet> m_Meshlets;
+    MeshVertexFormat m_VertexFormat;
+
+    std::atomic<bool> m_IsDataReleased;
+    size_t m_VertexCount, m_IndexCount;
+    std::atomic<bool> m_IsLoading;
 };
@@ -0,0 +1,777 @@
+#include "Entity/Assets/MeshOptimizer.h"
+
+#include <cmath>
+#include <tuple>
+
+namespace
+{
+    // Scoring parameters from Tom Forsyth's "Linear-Speed Vertex Cache Optimisation"
+    constexpr uint32_t FORSYTH_CACHE_SIZE = 32;
+    constexpr uint32_t MAX_VALENCE_SCORE = 32;
+    constexpr float CACHE_DECAY_POWER = 1.5f;
+    constexpr float LAST_TRIANGLE_SCORE = 0.75f;
+    constexpr float VALENCE_BOOST_SCALE = 2.0f;
+    constexpr float VALENCE_BOOST_POWER = 0.5f;
+
+    constexpr uint32_t OVERDRAW_CACHE_SIZE = 16;
+    constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+    constexpr size_t MAX_LOD_COUNT = 4;
+    constexpr size_t MIN_LOD_TRIANGLES = 32;
+    // Every level aims for half the triangles, a level that gets less than 20% simpler is not worth it
+    constexpr float LOD_REDUCTION = 0.5f;
+    constexpr float LOD_MIN_REDUCTION = 0.8f;
+    // Relative to the bounding box diagonal
+    constexpr float LOD_MAX_ERROR = 0.05f;
+
+    constexpr uint32_t MAX_MESHLET_VERTICES = 64;
+    constexpr uint32_t MAX_MESHLET_TRIANGLES = 124;
+
+    struct ScoreTables
+    {
+        ScoreTables()
+        {
+            for (uint32_t i = 0; i < FORSYTH_CACHE_SIZE; i++)
+            {
+                // The vertices of the last triangle get a fixed score, so the next triangle does not just reuse them
+                cache[i] = i < 3 ? LAST_TRIANGLE_SCORE
+                                 : std::pow(1.0f - static_cast<float>(i - 3) / (FORSYTH_CACHE_SIZE - 3), CACHE_DECAY_POWER);
+            }
+            valence[0] = 0.0f;
+            for (uint32_t i = 1; i < MAX_VALENCE_SCORE; i++)
+                valence[i] = VALENCE_BOOST_SCALE * std::pow(static_cast<float>(i), -VALENCE_BOOST_POWER);
+        }
+
+        float cache[FORSYTH_CACHE_SIZE];
+        float valence[MAX_VALENCE_SCORE];
+    };
+
+    float getVertexScore(const ScoreTables& tables, const int32_t cachePosition, const uint32_t liveTriangles)
+    {
+        // Vertices without remaining triangles must never attract a triangle
+        if (liveTriangles == 0)
+            return -1.0f;
+
+        float score = cachePosition >= 0 ? tables.cache[cachePosition] : 0.0f;
+        score += liveTriangles < MAX_VALENCE_SCORE
+            ? tables.valence[liveTriangles]
+            : VALENCE_BOOST_SCALE * std::pow(static_cast<float>(liveTriangles), -VALENCE_BOOST_POWER);
+        return score;
+    }
+
+    // Sum of squared distances to the planes of the triangles around a vertex, weighted by triangle area
+    struct Quadric
+    {
+        double a00 = 0.0, a01 = 0.0, a02 = 0.0, a03 = 0.0, a11 = 0.0, a12 = 0.0, a13 = 0.0, a22 = 0.0, a23 = 0.0,
+               a33 = 0.0;
+        double weight = 0.0;
+
+        void AddPlane(const glm::vec3& normal, const float distance, const float planeWeight)
+        {
+            const double x = normal.x, y = normal.y, z = normal.z, d = distance, w = planeWeight;
+            a00 += w * x * x; a01 += w * x * y; a02 += w * x * z; a03 += w * x * d;
+            a11 += w * y * y; a12 += w * y * z; a13 += w * y * d;
+            a22 += w * z * z; a23 += w * z * d;
+            a33 += w * d * d;
+            weight += w;
+        }
+
+        void Add(const Quadric& other)
+        {
+            a00 += other.a00; a01 += other.a01; a02 += other.a02; a03 += other.a03;
+            a11 += other.a11; a12 += other.a12; a13 += other.a13;
+            a22 += other.a22; a23 += other.a23;
+            a33 += other.a33;
+            weight += other.weight;
+        }
+
+        // Average squared distance of the point to the planes
+        double Evaluate(const glm::vec3& point) const
+        {
+            const double x = point.x, y = point.y, z = point.z;
+            const double error = a00 * x * x + a11 * y * y + a22 * z * z + 2.0 * (a01 * x * y + a02 * x * z + a12 * y * z) +
+                2.0 * (a03 * x + a13 * y + a23 * z) + a33;
+            return weight > 0.0 ? std::abs(error) / weight : 0.0;
+        }
+    };
+
+    // FIFO cache simulation with timestamps, a vertex is cached if it was transformed less than cacheSize misses ago
+    struct FifoCache
+    {
+        FifoCache(const size_t vertexCount, const uint32_t cacheSize) :
+            timestamps(vertexCount, 0), timestamp(cacheSize + 1), size(cacheSize)
+        {}
+
+        uint32_t Access(const uint32_t vertex)
+        {
+            if (timestamp - timestamps[vertex] <= size)
+                return 0;
+            timestamps[vertex] = timestamp++;
+            return 1;
+        }
+
+        uint32_t AccessTriangle(const uint32_t* triangle)
+        {
+            return Access(triangle[0]) + Access(triangle[1]) + Access(triangle[2]);
+        }
+
+        void Reset() { timestamp += size + 1; }
+
+        std::vector<uint32_t> timestamps;
+        uint32_t timestamp;
+        uint32_t size;
+    };
+}
+
+MeshOptimizer::VertexCacheStatistics MeshOptimizer::AnalyzeVertexCache(const std::vector<uint32_t>& indices,
+                                                                      const size_t vertexCount, const uint32_t cacheSize)
+{
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0)
+        return {0.0f, 0.0f};
+
+    FifoCache cache(vertexCount, cacheSize);
+    std::vector<uint8_t> referenced(vertexCount, 0);
+    size_t misses = 0, referencedCount = 0;
+    for (size_t i = 0; i < triangleCount * 3; i++)
+    {
+        misses += cache.Access(indices[i]);
+        if (!referenced[indices[i]])
+        {
+            referenced[indices[i]] = 1;
+            referencedCount++;
+        }
+    }
+
+    return {static_cast<float>(misses) / static_cast<float>(triangleCount),
+            static_cast<float>(misses) / static_cast<float>(referencedCount)};
+}
+
+void MeshOptimizer::OptimizeVertexCache(std::vector<uint32_t>& indices, const size_t vertexCount)
+{
+    static const ScoreTables scoreTables;
+
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0)
+        return;
+
+    // Triangles per vertex, the live part of a vertex's list shrinks as its triangles get emitted
+    std::vector<uint32_t> liveTriangles(vertexCount, 0);
+    for (size_t i = 0; i < triangleCount * 3; i++)
+        liveTriangles[indices[i]]++;
+    std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+    for (size_t i = 0; i < vertexCount; i++)
+        adjacencyOffsets[i + 1] = adjacencyOffsets[i] + liveTriangles[i];
+    std::vector<uint32_t> adjacency(triangleCount * 3);
+    {
+        std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (size_t i = 0; i < triangleCount * 3; i++)
+            adjacency[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+    }
+
+    std::vector<int32_t> cachePositions(vertexCount, -1);
+    std::vector<float> vertexScores(vertexCount);
+    for (size_t i = 0; i < vertexCount; i++)
+        vertexScores[i] = getVertexScore(scoreTables, -1, liveTriangles[i]);
+
+    std::vector<float> triangleScores(triangleCount);
+    uint32_t bestTriangle = 0;
+    for (size_t i = 0; i < triangleCount; i++)
+    {
+        triangleScores[i] = vertexScores[indices[i * 3]] + vertexScores[indices[i * 3 + 1]] + vertexScores[indices[i * 3 + 2]];
+        if (triangleScores[i] > triangleScores[bestTriangle])
+            bestTriangle = static_cast<uint32_t>(i);
+    }
+
+    std::vector<uint8_t> emitted(triangleCount, 0);
+    std::vector<uint32_t> output;
+    output.reserve(triangleCount * 3);
+    std::vector<uint32_t> cache, newCache;
+    cache.reserve(FORSYTH_CACHE_SIZE + 3);
+    newCache.reserve(FORSYTH_CACHE_SIZE + 3);
+    size_t inputCursor = 0;
+
+    for (size_t emittedCount = 0; emittedCount < triangleCount; emittedCount++)
+    {
+        if (bestTriangle == INVALID_INDEX)
+        {
+            // Nothing in the cache has triangles left, continue with the next triangle in input order
+            while (emitted[inputCursor])
+                inputCursor++;
+            bestTriangle = static_cast<uint32_t>(inputCursor);
+        }
+
+        const uint32_t* triangle = &indices[static_cast<size_t>(bestTriangle) * 3];
+        output.insert(output.end(), triangle, triangle + 3);
+        emitted[bestTriangle] = 1;
+
+        newCache.clear();
+        for (int32_t i = 0; i < 3; i++)
+        {
+            const uint32_t vertex = triangle[i];
+            uint32_t* vertexTriangles = &adjacency[adjacencyOffsets[vertex]];
+            const uint32_t live = liveTriangles[vertex];
+            for (uint32_t j = 0; j < live; j++)
+            {
+                if (vertexTriangles[j] == bestTriangle)
+                {
+                    std::swap(vertexTriangles[j], vertexTriangles[live - 1]);
+                    break;
+                }
+            }
+            liveTriangles[vertex]--;
+            if (std::find(newCache.begin(), newCache.end(), vertex) == newCache.end())
+                newCache.push_back(vertex);
+        }
+        for (const uint32_t vertex : cache)
+        {
+            if (std::find(newCache.begin(), newCache.end(), vertex) == newCache.end())
+                newCache.push_back(vertex);
+        }
+
+        // Vertices pushed out of the cache lose their cache score, all others moved or lost a triangle
+        for (size_t i = 0; i < newCache.size(); i++)
+        {
+            const uint32_t vertex = newCache[i];
+            cachePositions[vertex] = i < FORSYTH_CACHE_SIZE ? static_cast<int32_t>(i) : -1;
+            vertexScores[vertex] = getVertexScore(scoreTables, cachePositions[vertex], liveTriangles[vertex]);
+        }
+
+        bestTriangle = INVALID_INDEX;
+        float bestScore = -1.0f;
+        for (const uint32_t vertex : newCache)
+        {
+            const uint32_t* vertexTriangles = &adjacency[adjacencyOffsets[vertex]];
+            for (uint32_t j = 0; j < liveTriangles[vertex]; j++)
+            {
+                const uint32_t triangleIndex = vertexTriangles[j];
+                const uint32_t* adjacentTriangle = &indices[static_cast<size_t>(triangleIndex) * 3];
+                triangleScores[triangleIndex] = vertexScores[adjacentTriangle[0]] + vertexScores[adjacentTriangle[1]] +
+                    vertexScores[adjacentTriangle[2]];
+                if (triangleScores[triangleIndex] > bestScore)
+                {
+                    bestScore = triangleScores[triangleIndex];
+                    bestTriangle = triangleIndex;
+                }
+            }
+        }
+
+        newCache.resize(std::min<size_t>(newCache.size(), FORSYTH_CACHE_SIZE));
+        std::swap(cache, newCache);
+    }
+
+    indices = std::move(output);
+}
+
+void MeshOptimizer::OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<MeshVertex>& vertices,
+                                     const float threshold)
+{
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0)
+        return;
+
+    // Clusters start where the cache optimizer jumped to a new area (all three vertices missed). These are split
+    // further wherever the ACMR so far is already as good as the whole cluster's, so reordering costs little.
+    FifoCache cache(vertices.size(), OVERDRAW_CACHE_SIZE);
+    std::vector<uint32_t> hardBoundaries;
+    for (size_t i = 0; i < triangleCount; i++)
+    {
+        if (cache.AccessTriangle(&indices[i * 3]) == 3)
+            hardBoundaries.push_back(static_cast<uint32_t>(i));
+    }
+    hardBoundaries.push_back(static_cast<uint32_t>(triangleCount));
+
+    std::vector<uint32_t> clusters;
+    for (size_t c = 0; c + 1 < hardBoundaries.size(); c++)
+    {
+        const uint32_t start = hardBoundaries[c], end = hardBoundaries[c + 1];
+        cache.Reset();
+        uint32_t clusterMisses = 0;
+        for (uint32_t i = start; i < end; i++)
+            clusterMisses += cache.AccessTriangle(&indices[static_cast<size_t>(i) * 3]);
+        const float clusterThreshold = threshold * static_cast<float>(clusterMisses) / static_cast<float>(end - start);
+
+        cache.Reset();
+        clusters.push_back(start);
+        uint32_t clusterStart = start, misses = 0;
+        for (uint32_t i = start; i + 1 < end; i++)
+        {
+            misses += cache.AccessTriangle(&indices[static_cast<size_t>(i) * 3]);
+            if (static_cast<float>(misses) / static_cast<float>(i - clusterStart + 1) <= clusterThreshold)
+            {
+                clusterStart = i + 1;
+                misses = 0;
+                cache.Reset();
+                clusters.push_back(clusterStart);
+            }
+        }
+    }
+    clusters.push_back(static_cast<uint32_t>(triangleCount));
+
+    // Clusters facing away from the mesh center are likely in front of the others, so they are drawn first
+    auto getTriangle = [&indices, &vertices](const size_t triangle, glm::vec3& centroid, glm::vec3& normal) {
+        const glm::vec3& p0 = vertices[indices[triangle * 3]].Position;
+        const glm::vec3& p1 = vertices[indices[triangle * 3 + 1]].Position;
+        const glm::vec3& p2 = vertices[indices[triangle * 3 + 2]].Position;
+        centroid = (p0 + p1 + p2) / 3.0f;
+        normal = glm::cross(p1 - p0, p2 - p0);
+    };
+
+    glm::vec3 meshCentroid(0.0f);
+    float meshArea = 0.0f;
+    for (size_t i = 0; i < triangleCount; i++)
+    {
+        glm::vec3 centroid, normal;
+        getTriangle(i, centroid, normal);
+        const float area = glm::length(normal);
+        meshCentroid += centroid * area;
+        meshArea += area;
+    }
+    if (meshArea > 0.0f)
+        meshCentroid /= meshArea;
+
+    const size_t clusterCount = clusters.size() - 1;
+    std::vector<float> sortKeys(clusterCount);
+    for (size_t c = 0; c < clusterCount; c++)
+    {
+        glm::vec3 clusterCentroid(0.0f), clusterNormal(0.0f);
+        float clusterArea = 0.0f;
+        for (uint32_t i = clusters[c]; i < clusters[c + 1]; i++)
+        {
+            glm::vec3 centroid, normal;
+            getTriangle(i, centroid, normal);
+            const float area = glm::length(normal);
+            clusterCentroid += centroid * area;
+            clusterNormal += normal;
+            clusterArea += area;
+        }
+        if (clusterArea > 0.0f)
+            clusterCentroid /= clusterArea;
+        const float normalLength = glm::length(clusterNormal);
+        if (normalLength > 0.0f)
+            clusterNormal /= normalLength;
+
+        sortKeys[c] = glm::dot(clusterCentroid - meshCentroid, clusterNormal);
+    }
+
+    std::vector<uint32_t> clusterOrder(clusterCount);
+    for (size_t c = 0; c < clusterCount; c++)
+        clusterOrder[c] = static_cast<uint32_t>(c);
+    std::stable_sort(clusterOrder.begin(), clusterOrder.end(),
+                     [&sortKeys](const uint32_t a, const uint32_t b) { return sortKeys[a] > sortKeys[b]; });
+
+    std::vector<uint32_t> output;
+    output.reserve(triangleCount * 3);
+    for (const uint32_t c : clusterOrder)
+        output.insert(output.end(), indices.begin() + clusters[c] * 3, indices.begin() + clusters[c + 1] * 3);
+    indices = std::move(output);
+}
+
+void MeshOptimizer::OptimizeVertexFetch(std::vector<MeshVertex>& vertices, std::vector<uint32_t>& indices)
+{
+    std::vector<uint32_t> remap(vertices.size(), INVALID_INDEX);
+    std::vector<MeshVertex> output;
+    output.reserve(vertices.size());
+    for (auto& index : indices)
+    {
+        if (remap[index] == INVALID_INDEX)
+        {
+            remap[index] = static_cast<uint32_t>(output.size());
+            output.push_back(vertices[index]);
+        }
+        index = remap[index];
+    }
+    vertices = std::move(output);
+}
+
+void MeshOptimizer::OptimizeMesh(const std::string& name, std::vector<MeshVertex>& vertices, std::vector<uint32_t>& indices)
+{
+    if (indices.empty() || indices.size() % 3 != 0)
+        return;
+
+    const VertexCacheStatistics before = AnalyzeVertexCache(indices, vertices.size());
+    OptimizeVertexCache(indices, vertices.size());
+    OptimizeOverdraw(indices, vertices);
+    OptimizeVertexFetch(vertices, indices);
+    const VertexCacheStatistics after = AnalyzeVertexCache(indices, vertices.size());
+
+    SPDLOG_DEBUG("Optimized mesh " + name + ": ACMR " + std::to_string(before.acmr) + " -> " +
+                 std::to_string(after.acmr) + ", ATVR " + std::to_string(before.atvr) + " -> " +
+                 std::to_string(after.atvr));
+}
+
+float MeshOptimizer::Simplify(const std::vector<MeshVertex>& vertices, const std::vector<uint32_t>& indices,
+                              std::vector<uint32_t>& outIndices, const size_t targetIndexCount, const float maxError)
+{
+    outIndices = indices;
+    outIndices.resize(outIndices.size() - outIndices.size() % 3);
+    const size_t vertexCount = vertices.size();
+    if (outIndices.size() <= targetIndexCount || vertexCount == 0)
+        return 0.0f;
+
+    // Vertices at the same position (split at UV or normal seams) share one quadric and are never moved
+    std::vector<uint32_t> sortedVertices(vertexCount);
+    for (size_t i = 0; i < vertexCount; i++)
+        sortedVertices[i] = static_cast<uint32_t>(i);
+    std::sort(sortedVertices.begin(), sortedVertices.end(), [&vertices](const uint32_t a, const uint32_t b) {
+        const glm::vec3& pa = vertices[a].Position;
+        const glm::vec3& pb = vertices[b].Position;
+        return std::tie(pa.x, pa.y, pa.z) < std::tie(pb.x, pb.y, pb.z);
+    });
+    std::vector<uint32_t> canonical(vertexCount);
+    std::vector<uint8_t> locked(vertexCount, 0);
+    for (size_t i = 0; i < vertexCount;)
+    {
+        size_t end = i + 1;
+        while (end < vertexCount && vertices[sortedVertices[end]].Position == vertices[sortedVertices[i]].Position)
+            end++;
+        for (size_t j = i; j < end; j++)
+        {
+            canonical[sortedVertices[j]] = sortedVertices[i];
+            locked[sortedVertices[j]] = end - i > 1;
+        }
+        i = end;
+    }
+
+    // Edges that are not shared by exactly two triangles are borders, their vertices stay in place as well
+    std::unordered_map<uint64_t, uint32_t> edgeUsage;
+    edgeUsage.reserve(outIndices.size());
+    for (size_t i = 0; i < outIndices.size(); i += 3)
+    {
+        for (size_t e = 0; e < 3; e++)
+        {
+            const uint32_t a = canonical[outIndices[i + e]], b = canonical[outIndices[i + (e + 1) % 3]];
+            edgeUsage[static_cast<uint64_t>(std::min(a, b)) << 32 | std::max(a, b)]++;
+        }
+    }
+    std::vector<uint8_t> lockedCanonical(vertexCount, 0);
+    for (const auto& [edge, usage] : edgeUsage)
+    {
+        if (usage != 2)
+        {
+            lockedCanonical[edge >> 32] = 1;
+            lockedCanonical[edge & UINT32_MAX] = 1;
+        }
+    }
+    for (size_t i = 0; i < vertexCount; i++)
+        locked[i] |= lockedCanonical[canonical[i]];
+
+    std::vector<Quadric> quadrics(vertexCount);
+    for (size_t i = 0; i < outIndices.size(); i += 3)
+    {
+        const glm::vec3& p0 = vertices[outIndices[i]].Position;
+        const glm::vec3& p1 = vertices[outIndices[i + 1]].Position;
+        const glm::vec3& p2 = vertices[outIndices[i + 2]].Position;
+        const glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+        const float area = glm::length(normal);
+        if (area == 0.0f)
+            continue;
+        const glm::vec3 planeNormal = normal / area;
+        for (size_t c = 0; c < 3; c++)
+            quadrics[canonical[outIndices[i + c]]].AddPlane(planeNormal, -glm::dot(planeNormal, p0), area);
+    }
+
+    // Collapses happen in passes ordered by cost, a vertex is touched at most once per pass so the checks stay valid
+    const double maxErrorSquared = static_cast<double>(maxError) * maxError;
+    double resultError = 0.0;
+    std::vector<uint32_t> adjacencyOffsets(vertexCount + 1), adjacency, bestTargets(vertexCount);
+    std::vector<double> bestCosts(vertexCount);
+    std::vector<uint32_t> candidates;
+    std::vector<uint8_t> touched(vertexCount);
+    while (outIndices.size() > targetIndexCount)
+    {
+        std::fill(adjacencyOffsets.begin(), adjacencyOffsets.end(), 0);
+        for (const uint32_t index : outIndices)
+            adjacencyOffsets[index + 1]++;
+        for (size_t i = 0; i < vertexCount; i++)
+            adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+        adjacency.resize(outIndices.size());
+        {
+            std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+            for (size_t i = 0; i < outIndices.size(); i++)
+                adjacency[fill[outIndices[i]]++] = static_cast<uint32_t>(i / 3);
+        }
+
+        std::fill(bestTargets.begin(), bestTargets.end(), INVALID_INDEX);
+        auto considerCollapse = [&](const uint32_t source, const uint32_t target) {
+            if (locked[source] || canonical[source] == canonical[target])
+                return;
+            const double cost = quadrics[canonical[source]].Evaluate(vertices[target].Position);
+            if (bestTargets[source] == INVALID_INDEX || cost < bestCosts[source])
+            {
+                bestTargets[source] = target;
+                bestCosts[source] = cost;
+            }
+        };
+        for (size_t i = 0; i < outIndices.size(); i += 3)
+        {
+            for (size_t e = 0; e < 3; e++)
+            {
+                considerCollapse(outIndices[i + e], outIndices[i + (e + 1) % 3]);
+                considerCollapse(outIndices[i + (e + 1) % 3], outIndices[i + e]);
+            }
+        }
+
+        candidates.clear();
+        for (size_t i = 0; i < vertexCount; i++)
+        {
+            if (bestTargets[i] != INVALID_INDEX && bestCosts[i] <= maxErrorSquared)
+                candidates.push_back(static_cast<uint32_t>(i));
+        }
+        std::sort(candidates.begin(), candidates.end(),
+                  [&bestCosts](const uint32_t a, const uint32_t b) { return bestCosts[a] < bestCosts[b]; });
+
+        std::fill(touched.begin(), touched.end(), 0);
+        size_t indexCount = outIndices.size();
+        size_t collapseCount = 0;
+        for (const uint32_t source : candidates)
+        {
+            if (indexCount <= targetIndexCount)
+                break;
+            const uint32_t target = bestTargets[source];
+            if (touched[source] || touched[target])
+                continue;
+
+            // Moving the vertex must not flip or turn any of the remaining triangles around it by more than 60 degrees
+            bool flips = false;
+            const glm::vec3& sourcePosition = vertices[source].Position;
+            const glm::vec3& targetPosition = vertices[target].Position;
+            for (uint32_t a = adjacencyOffsets[source]; a < adjacencyOffsets[source + 1] && !flips; a++)
+            {
+                const uint32_t* triangle = &outIndices[static_cast<size_t>(adjacency[a]) * 3];
+                if (triangle[0] == target || triangle[1] == target || triangle[2] == target)
+                    continue;
+                const int32_t corner = triangle[0] == source ? 0 : triangle[1] == source ? 1 : 2;
+                const glm::vec3& p1 = vertices[triangle[(corner + 1) % 3]].Position;
+                const glm::vec3& p2 = vertices[triangle[(corner + 2) % 3]].Position;
+                const glm::vec3 oldNormal = glm::cross(p1 - sourcePosition, p2 - sourcePosition);
+                const glm::vec3 newNormal = glm::cross(p1 - targetPosition, p2 - targetPosition);
+                flips = glm::dot(oldNormal, newNormal) <= 0.5f * glm::length(oldNormal) * glm::length(newNormal);
+            }
+            if (flips)
+                continue;
+
+            for (uint32_t a = adjacencyOffsets[source]; a < adjacencyOffsets[source + 1]; a++)
+            {
+                uint32_t* triangle = &outIndices[static_cast<size_t>(adjacency[a]) * 3];
+                const bool collapses = triangle[0] == target || triangle[1] == target || triangle[2] == target;
+                for (size_t c = 0; c < 3; c++)
+                {
+                    touched[triangle[c]] = 1;
+                    if (triangle[c] == source)
+                        triangle[c] = target;
+                }
+                if (collapses)
+                    indexCount -= 3;
+            }
+            quadrics[canonical[target]].Add(quadrics[canonical[source]]);
+            resultError = std::max(resultError, bestCosts[source]);
+            collapseCount++;
+        }
+        if (collapseCount == 0)
+            break;
+
+        size_t writeIndex = 0;
+        for (size_t i = 0; i < outIndices.size(); i += 3)
+        {
+            const uint32_t a = outIndices[i], b = outIndices[i + 1], c = outIndices[i + 2];
+            if (a == b || b == c || a == c)
+                continue;
+            outIndices[writeIndex++] = a;
+            outIndices[writeIndex++] = b;
+            outIndices[writeIndex++] = c;
+        }
+        outIndices.resize(writeIndex);
+    }
+
+    return static_cast<float>(std::sqrt(resultError));
+}
+
+void MeshOptimizer::GenerateLods(const std::string& name, const std::vector<MeshVertex>& vertices,
+                                 const std::vector<uint32_t>& indices, std::vector<MeshLod>& outLods)
+{
+    outLods.clear();
+    if (vertices.empty() || indices.size() < MIN_LOD_TRIANGLES * 3)
+        return;
+
+    glm::vec3 minPosition = vertices[0].Position, maxPosition = vertices[0].Position;
+    for (const auto& vertex : vertices)
+    {
+        minPosition = glm::min(minPosition, vertex.Position);
+        maxPosition = glm::max(maxPosition, vertex.Position);
+    }
+    const float maxError = glm::length(maxPosition - minPosition) * LOD_MAX_ERROR;
+
+    float error = 0.0f;
+    for (size_t level = 0; level < MAX_LOD_COUNT; level++)
+    {
+        const std::vector<uint32_t>& sourceIndices = outLods.empty() ? indices : outLods.back().indices;
+        const size_t targetIndexCount = static_cast<size_t>(sourceIndices.size() / 3 * LOD_REDUCTION) * 3;
+        if (targetIndexCount < MIN_LOD_TRIANGLES * 3)
+            break;
+
+        // Every level is simplified from the previous one, so its errors add up
+        MeshLod lod;
+        const float levelError = Simplify(vertices, sourceIndices, lod.indices, targetIndexCount, maxError - error);
+        if (lod.indices.size() > static_cast<size_t>(sourceIndices.size() * LOD_MIN_REDUCTION))
+            break;
+
+        error += levelError;
+        lod.error = error;
+        OptimizeVertexCache(lod.indices, vertices.size());
+        outLods.push_back(std::move(lod));
+    }
+
+    if (!outLods.empty())
+    {
+        SPDLOG_DEBUG("Generated " + std::to_string(outLods.size()) + " LODs for mesh " + name + ", " +
+                     std::to_string(indices.size() / 3) + " -> " + std::to_string(outLods.back().indices.size() / 3) +
+                     " triangles");
+    }
+}
+
+void MeshOptimizer::BuildMeshlets(const std::vector<MeshVertex>& vertices, const std::vector<uint32_t>& indices,
+                                  std::vector<Meshlet>& outMeshlets)
+{
+    outMeshlets.clear();
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount <= MAX_MESHLET_TRIANGLES)
+        return;
+
+    auto finishMeshlet = [&vertices, &indices, &outMeshlets](Meshlet& meshlet) {
+        // Bounding sphere around the center of the bounding box
+        glm::vec3 minPosition = vertices[indices[meshlet.FirstIndex]].Position, maxPosition = minPosition;
+        for (uint32_t i = meshlet.FirstIndex; i < meshlet.FirstIndex + meshlet.IndexCount; i++)
+        {
+            minPosition = glm::min(minPosition, vertices[indices[i]].Position);
+            maxPosition = glm::max(maxPosition, vertices[indices[i]].Position);
+        }
+        meshlet.Center = (minPosition + maxPosition) * 0.5f;
+        meshlet.Radius = 0.0f;
+        for (uint32_t i = meshlet.FirstIndex; i < meshlet.FirstIndex + meshlet.IndexCount; i++)
+            meshlet.Radius = std::max(meshlet.Radius, glm::length(vertices[indices[i]].Position - meshlet.Center));
+
+        // The cone contains all triangle normals, clusters that are too curved never get culled
+        std::vector<glm::vec3> normals;
+        normals.reserve(meshlet.IndexCount / 3);
+        glm::vec3 axis(0.0f);
+        for (uint32_t i = meshlet.FirstIndex; i < meshlet.FirstIndex + meshlet.IndexCount; i += 3)
+        {
+            const glm::vec3& p0 = vertices[indices[i]].Position;
+            const glm::vec3 normal = glm::cross(vertices[indices[i + 1]].Position - p0, vertices[indices[i + 2]].Position - p0);
+            const float length = glm::length(normal);
+            if (length == 0.0f)
+                continue;
+            normals.push_back(normal / length);
+            axis += normals.back();
+        }
+        const float axisLength = glm::length(axis);
+        meshlet.ConeAxis = axisLength > 0.0f ? axis / axisLength : glm::vec3(0.0f, 0.0f, 1.0f);
+        float minDot = axisLength > 0.0f ? 1.0f : -1.0f;
+        for (const auto& normal : normals)
+            minDot = std::min(minDot, glm::dot(normal, meshlet.ConeAxis));
+        meshlet.ConeCutoff = minDot <= 0.1f ? 1.0f : std::sqrt(1.0f - minDot * minDot);
+
+        outMeshlets.push_back(meshlet);
+    };
+
+    // Stamped with the meshlet index + 1, so the marks do not have to be cleared for every meshlet
+    std::vector<uint32_t> vertexMarks(vertices.size(), 0);
+    auto countNewVertices = [&vertexMarks](const uint32_t* triangle, const uint32_t stamp) {
+        uint32_t newVertices = 0;
+        for (int32_t c = 0; c < 3; c++)
+        {
+            const bool repeated = (c > 0 && triangle[c] == triangle[0]) || (c > 1 && triangle[c] == triangle[1]);
+            newVertices += vertexMarks[triangle[c]] != stamp && !repeated;
+        }
+        return newVertices;
+    };
+
+    Meshlet meshlet = {};
+    for (size_t i = 0; i < triangleCount; i++)
+    {
+        const uint32_t* triangle = &indices[i * 3];
+        if (meshlet.IndexCount / 3 == MAX_MESHLET_TRIANGLES ||
+            meshlet.VertexCount + countNewVertices(triangle, static_cast<uint32_t>(outMeshlets.size()) + 1) >
+                MAX_MESHLET_VERTICES)
+        {
+            finishMeshlet(meshlet);
+            meshlet = {};
+            meshlet.FirstIndex = static_cast<uint32_t>(i * 3);
+        }
+
+        const uint32_t stamp = static_cast<uint32_t>(outMeshlets.size()) + 1;
+        meshlet.VertexCount += countNewVertices(triangle, stamp);
+        for (int32_t c = 0; c < 3; c++)
+            vertexMarks[triangle[c]] = stamp;
+        meshlet.IndexCount += 3;
+    }
+    if (meshlet.IndexCount)
+        finishMeshlet(meshlet);
+}
+
+void MeshOptimizer::GenerateNormals(std::vector<MeshVertex>& vertices, const std::vector<uint32_t>& indices)
+{
+    for (size_t i = 0; i + 2 < indices.size(); i += 3)
+    {
+        MeshVertex& v0 = vertices[indices[i]];
+        MeshVertex& v1 = vertices[indices[i + 1]];
+        MeshVertex& v2 = vertices[indices[i + 2]];
+        // Not normalized, so bigger triangles have more influence
+        const glm::vec3 faceNormal = glm::cross(v1.Position - v0.Position, v2.Position - v0.Position);
+        v0.Normal += faceNormal;
+        v1.Normal += faceNormal;
+        v2.Normal += faceNormal;
+    }
+
+    for (auto& vertex : vertices)
+    {
+        const float length = glm::length(vertex.Normal);
+        if (length > 0.0f)
+            vertex.Normal /= length;
+    }
+}
+
+void MeshOptimizer::GenerateTangents(std::vector<MeshVertex>& vertices, const std::vector<uint32_t>& indices)
+{
+    // The triangles are accumulated into the vertices
+    for (auto& vertex : vertices)
+    {
+        vertex.Tangent = glm::vec3(0.0f);
+        vertex.Bitangent = glm::vec3(0.0f);
+    }
+
+    for (size_t i = 0; i + 2 < indices.size(); i += 3)
+    {
+        MeshVertex& v0 = vertices[indices[i]];
+        MeshVertex& v1 = vertices[indices[i + 1]];
+        MeshVertex& v2 = vertices[indices[i + 2]];
+
+        const glm::vec3 edge1 = v1.Position - v0.Position;
+        const glm::vec3 edge2 = v2.Position - v0.Position;
+        const glm::vec2 deltaUV1 = v1.TexCoords - v0.TexCoords;
+        const glm::vec2 deltaUV2 = v2.TexCoords - v0.TexCoords;
+        const float determinant = deltaUV1.x * deltaUV2.y - deltaUV2.x * deltaUV1.y;
+        if (std::abs(determinant) < 1e-12f)
+            continue;
+
+        const float inverseDeterminant = 1.0f / determinant;
+        const glm::vec3 tangent = (edge1 * deltaUV2.y - edge2 * deltaUV1.y) * inverseDeterminant;
+        const glm::vec3 bitangent = (edge2 * deltaUV1.x - edge1 * deltaUV2.x) * inverseDeterminant;
+        for (MeshVertex* vertex : {&v0, &v1, &v2})
+        {
+            vertex->Tangent += tangent;
+            vertex->Bitangent += bitangent;
+        }
+    }
+
+    for (auto& vertex : vertices)
+    {
+        // Gram-Schmidt, so the tangent frame stays orthogonal to the normal
+        const glm::vec3 tangent = vertex.Tangent - vertex.Normal * glm::dot(vertex.Normal, vertex.Tangent);
+        if (glm::length(tangent) > 0.0f)
+            vertex.Tangent = glm::normalize(tangent);
+        if (glm::length(vertex.Bitangent) > 0.0f)
+            vertex.Bitangent = glm::normalize(vertex.Bitangent);
+    }
+}
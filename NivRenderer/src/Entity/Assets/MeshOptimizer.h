@@ -0,0 +1,50 @@
+#pragma once
+#include "Base.h"
+#include "Entity/Assets/MeshAsset.h"
+
+// Reorders imported meshes for the GPU: triangles for post-transform vertex cache reuse (Forsyth), then
+// clusters of those triangles front to back to reduce overdraw, and finally the vertices in the order
+// they are first used, so vertex fetch reads memory linearly. The result renders exactly like the input.
+namespace MeshOptimizer
+{
+    struct VertexCacheStatistics
+    {
+        // Average cache miss ratio, transformed vertices per triangle (0.5 - 3.0, lower is better)
+        float acmr;
+        // Average transform to vertex ratio, transformed vertices per referenced vertex (1.0 is optimal)
+        float atvr;
+    };
+
+    // Simulates a FIFO post-transform cache, which is close to what current GPUs do
+    VertexCacheStatistics AnalyzeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount,
+                                             uint32_t cacheSize = 16);
+
+    void OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount);
+    // Expects cache optimized indices. Clusters may only get split where it costs at most threshold times the ACMR
+    void OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<MeshVertex>& vertices,
+                          float threshold = 1.05f);
+    // Unreferenced vertices are removed
+    void OptimizeVertexFetch(std::vector<MeshVertex>& vertices, std::vector<uint32_t>& indices);
+
+    // Runs all stages and logs the statistics before and after
+    void OptimizeMesh(const std::string& name, std::vector<MeshVertex>& vertices, std::vector<uint32_t>& indices);
+
+    // Quadric error edge collapse towards targetIndexCount, stops early once a collapse would move the surface by
+    // more than maxError. Vertices are only moved onto existing vertices, so the result indexes the same vertices.
+    // Borders and UV/normal seams are kept in place. Returns the largest quadric error of a collapse as an RMS distance
+    // in object space units.
+    float Simplify(const std::vector<MeshVertex>& vertices, const std::vector<uint32_t>& indices,
+                   std::vector<uint32_t>& outIndices, size_t targetIndexCount, float maxError);
+    // Splits the triangles into meshlets in index order, so cache optimized indices give compact clusters.
+    // Leaves outMeshlets empty if the mesh fits into a single meshlet.
+    void BuildMeshlets(const std::vector<MeshVertex>& vertices, const std::vector<uint32_t>& indices,
+                       std::vector<Meshlet>& outMeshlets);
+    // Builds coarser levels of detail (excluding LOD 0, the mesh itself) until the mesh does not get simpler
+    void GenerateLods(const std::string& name, const std::vector<MeshVertex>& vertices,
+                      const std::vector<uint32_t>& indices, std::vector<MeshLod>& outLods);
+
+    // Area weighted vertex normals, for meshes that come without them
+    void GenerateNormals(std::vector<MeshVertex>& vertices, const std::vector<uint32_t>& indices);
+    // Per vertex tangent frame from the UV gradients, orthogonalized against the normal
+    void GenerateTangents(std::vector<MeshVertex>& vertices, const std::vector<uint32_t>& indices);
+}
@@ -0,0 +1,205 @@
+#include "Entity/Assets/ModelCache.h"
+
+#include <filesystem>
+#include <type_traits>
+
+#include "Application/Util/FileUtils.h"
+#include "Entity/Assets/AssetManager.h"
+
+static_assert(std::is_trivially_copyable_v<MeshVertex>, "MeshVertex is written to the model cache as raw bytes");
+static_assert(std::is_trivially_copyable_v<Meshlet>, "Meshlet is written to the model cache as raw bytes");
+
+namespace
+{
+    struct CacheWriteContext
+    {
+        std::unordered_map<MeshAsset*, int32_t> meshIndices;
+        std::unordered_map<MaterialAsset*, int32_t> materialIndices;
+        std::vector<MeshAsset*> meshes;
+        std::vector<MaterialAsset*> materials;
+    };
+
+    void gatherAssets(const std::vector<SubModel>& subModels, CacheWriteContext& context)
+    {
+        for (const auto& subModel : subModels)
+        {
+            MeshAsset* meshAsset = subModel.GetMesh();
+            if (meshAsset && !context.meshIndices.contains(meshAsset))
+            {
+                context.meshIndices[meshAsset] = static_cast<int32_t>(context.meshes.size());
+                context.meshes.push_back(meshAsset);
+            }
+            MaterialAsset* materialAsset = subModel.GetMaterial();
+            if (materialAsset && !context.materialIndices.contains(materialAsset))
+            {
+                context.materialIndices[materialAsset] = static_cast<int32_t>(context.materials.size());
+                context.materials.push_back(materialAsset);
+            }
+            gatherAssets(subModel.subModels, context);
+        }
+    }
+
+    void writeNodes(std::ofstream& stream, const std::vector<SubModel>& subModels, const CacheWriteContext& context)
+    {
+        FileUtils::WriteValue(stream, static_cast<uint32_t>(subModels.size()));
+        for (const auto& subModel : subModels)
+        {
+            FileUtils::WriteString(stream, subModel.name);
+            FileUtils::WriteValue(stream, subModel.modelMatrix);
+            MeshAsset* meshAsset = subModel.GetMesh();
+            MaterialAsset* materialAsset = subModel.GetMaterial();
+            FileUtils::WriteValue(stream, meshAsset ? context.meshIndices.at(meshAsset) : -1);
+            FileUtils::WriteValue(stream, materialAsset ? context.materialIndices.at(materialAsset) : -1);
+            writeNodes(stream, subModel.subModels, context);
+        }
+    }
+
+    bool readNodes(std::ifstream& stream, std::vector<CachedNode>& nodes, const CachedModel& model)
+    {
+        uint32_t nodeCount;
+        if (!FileUtils::ReadValue(stream, nodeCount))
+            return false;
+
+        nodes.resize(nodeCount);
+        for (auto& node : nodes)
+        {
+            if (!FileUtils::ReadString(stream, node.name) || !FileUtils::ReadValue(stream, node.modelMatrix) ||
+                !FileUtils::ReadValue(stream, node.meshIndex) || !FileUtils::ReadValue(stream, node.materialIndex))
+                return false;
+            if (node.meshIndex >= static_cast<int32_t>(model.meshes.size()) ||
+                node.materialIndex >= static_cast<int32_t>(model.materials.size()))
+                return false;
+            if (!readNodes(stream, node.children, model))
+                return false;
+        }
+        return true;
+    }
+}
+
+ModelCache::ModelCache(const std::string& cacheDirectory) : m_CacheDirectory(cacheDirectory)
+{
+}
+
+bool ModelCache::Read(const std::string& sourcePath, const ImportProfile importProfile, CachedModel& outModel,
+                      const bool validateSource) const
+{
+    const std::string cacheFilePath = getCacheFilePath(sourcePath);
+    std::ifstream stream(cacheFilePath, std::ios::binary);
+    if (!stream.is_open())
+        return false;
+
+    uint32_t magic, version, cachedImportProfile, cachedImportFlags;
+    int64_t cachedTimestamp;
+    std::string cachedSourcePath;
+    if (!FileUtils::ReadValue(stream, magic) || !FileUtils::ReadValue(stream, version) ||
+        !FileUtils::ReadValue(stream, cachedImportProfile) || !FileUtils::ReadValue(stream, cachedImportFlags) ||
+        !FileUtils::ReadValue(stream, cachedTimestamp) || !FileUtils::ReadString(stream, cachedSourcePath))
+        return false;
+
+    if (magic != CACHE_MAGIC || version != CACHE_VERSION || cachedImportProfile != static_cast<uint32_t>(importProfile) ||
+        cachedImportFlags != ImportSettings::Get(importProfile).postProcessFlags ||
+        (validateSource && cachedTimestamp != FileUtils::GetLastWriteTime(sourcePath)) || cachedSourcePath != sourcePath)
+    {
+        SPDLOG_DEBUG("Model cache for " + sourcePath + " is outdated");
+        return false;
+    }
+
+    uint32_t meshCount;
+    if (!FileUtils::ReadString(stream, outModel.name) || !FileUtils::ReadValue(stream, meshCount))
+        return false;
+    outModel.meshes.resize(meshCount);
+    for (auto& mesh : outModel.meshes)
+    {
+        uint32_t lodCount;
+        if (!FileUtils::ReadString(stream, mesh.path) || !FileUtils::ReadVector(stream, mesh.vertices) ||
+            !FileUtils::ReadVector(stream, mesh.indices) || !FileUtils::ReadValue(stream, lodCount))
+            return false;
+        mesh.lods.resize(lodCount);
+        for (auto& lod : mesh.lods)
+        {
+            if (!FileUtils::ReadValue(stream, lod.error) || !FileUtils::ReadVector(stream, lod.indices))
+                return false;
+        }
+        if (!FileUtils::ReadVector(stream, mesh.meshlets))
+            return false;
+    }
+
+    uint32_t materialCount;
+    if (!FileUtils::ReadValue(stream, materialCount))
+        return false;
+    outModel.materials.resize(materialCount);
+    for (auto& material : outModel.materials)
+    {
+        if (!FileUtils::ReadString(stream, material.name) || !FileUtils::ReadString(stream, material.diffusePath) ||
+            !FileUtils::ReadString(stream, material.normalPath) || !FileUtils::ReadString(stream, material.metallicPath) ||
+            !FileUtils::ReadString(stream, material.roughnessPath) || !FileUtils::ReadString(stream, material.aoPath) ||
+            !FileUtils::ReadString(stream, material.emissivePath))
+            return false;
+    }
+
+    if (!readNodes(stream, outModel.nodes, outModel))
+    {
+        SPDLOG_DEBUG("Model cache for " + sourcePath + " is corrupted");
+        return false;
+    }
+
+    return true;
+}
+
+bool ModelCache::Write(const std::string& sourcePath, const ImportProfile importProfile, const Model& model) const
+{
+    std::error_code errorCode;
+    std::filesystem::create_directories(m_CacheDirectory, errorCode);
+
+    const std::string cacheFilePath = getCacheFilePath(sourcePath);
+    const bool written = FileUtils::WriteFileAtomic(cacheFilePath, [&](std::ofstream& stream) {
+        CacheWriteContext context;
+        gatherAssets(model.subModels, context);
+
+        FileUtils::WriteValue(stream, CACHE_MAGIC);
+        FileUtils::WriteValue(stream, CACHE_VERSION);
+        FileUtils::WriteValue(stream, static_cast<uint32_t>(importProfile));
+        FileUtils::WriteValue(stream, ImportSettings::Get(importProfile).postProcessFlags);
+        FileUtils::WriteValue(stream, FileUtils::GetLastWriteTime(sourcePath));
+        FileUtils::WriteString(stream, sourcePath);
+        FileUtils::WriteString(stream, model.name);
+
+        FileUtils::WriteValue(stream, static_cast<uint32_t>(context.meshes.size()));
+        for (const auto mesh : context.meshes)
+        {
+            FileUtils::WriteString(stream, mesh->GetPath());
+            FileUtils::WriteVector(stream, mesh->GetVertices());
+            FileUtils::WriteVector(stream, mesh->GetIndices());
+            FileUtils::WriteValue(stream, static_cast<uint32_t>(mesh->GetLods().size()));
+            for (const auto& lod : mesh->GetLods())
+            {
+                FileUtils::WriteValue(stream, lod.error);
+                FileUtils::WriteVector(stream, lod.indices);
+            }
+            FileUtils::WriteVector(stream, mesh->GetMeshlets());
+        }
+
+        FileUtils::WriteValue(stream, static_cast<uint32_t>(context.materials.size()));
+        for (const auto material : context.materials)
+        {
+            FileUtils::WriteString(stream, material->GetName());
+            FileUtils::WriteString(stream, material->GetDiffusePath());
+            FileUtils::WriteString(stream, material->GetNormalPath());
+            FileUtils::WriteString(stream, material->GetMetallicPath());
+            FileUtils::WriteString(stream, material->GetRoughnessPath());
+            FileUtils::WriteString(stream, material->GetAOPath());
+            FileUtils::WriteString(stream, material->GetEmissivePath());
+        }
+
+        writeNodes(stream, model.subModels, context);
+    });
+    if (!written)
+        SPDLOG_DEBUG("Could not write model cache " + cacheFilePath);
+
+    return written;
+}
+
+std::string ModelCache::getCacheFilePath(const std::string& sourcePath) const
+{
+    return m_CacheDirectory + '/' + FileUtils::ToHexString(FileUtils::HashString(sourcePath)) + ".nmc";
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include "Base.h"
+#include "Entity/Assets/ImportProfile.h"
+#include "Entity/Assets/MeshAsset.h"
+
+struct Model;
+struct SubModel;
+
+struct CachedMesh
+{
+    std::string path;
+    std::vector<MeshVertex> vertices;
+    std::vector<uint32_t> indices;
+    std::vector<MeshLod> lods;
+    std::vector<Meshlet> meshlets;
+};
+
+struct CachedMaterial
+{
+    std::string name;
+    std::string diffusePath, normalPath, metallicPath, roughnessPath, aoPath, emissivePath;
+};
+
+struct CachedNode
+{
+    CachedNode() : modelMatrix(1.0f), meshIndex(-1), materialIndex(-1) {}
+
+    std::string name;
+    glm::mat4 modelMatrix;
+    int32_t meshIndex;
+    int32_t materialIndex;
+    std::vector<CachedNode> children;
+};
+
+struct CachedModel
+{
+    std::string name;
+    std::vector<CachedMesh> meshes;
+    std::vector<CachedMaterial> materials;
+    std::vector<CachedNode> nodes;
+};
+
+// Binary on-disk cache of fully processed models. An entry is only valid for the source file's
+// modification time and the import profile (and its flags) it was created with, otherwise the model gets reimported.
+class ModelCache
+{
+public:
+    ModelCache(const std::string& cacheDirectory);
+
+    // Without validateSource an entry is also read if the source file changed since, which is used to restore data
+    // that was released after it was uploaded
+    bool Read(const std::string& sourcePath, ImportProfile importProfile, CachedModel& outModel,
+              bool validateSource = true) const;
+    // Returns false if the entry could not be written, meshes of the model can't be restored from it then
+    bool Write(const std::string& sourcePath, ImportProfile importProfile, const Model& model) const;
+
+private:
+    static constexpr uint32_t CACHE_MAGIC = 0x4D43494E; // "NICM"
+    static constexpr uint32_t CACHE_VERSION = 6;
+
+    std::string m_CacheDirectory;
+
+    std::string getCacheFilePath(const std::string& sourcePath) const;
+};
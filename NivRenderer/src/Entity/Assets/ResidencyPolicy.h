@@ -0,0 +1,53 @@
+#pragma once
+#include "Base.h"
+#include "json.hpp"
+
+// What happens to the CPU copy of an asset once it is on the GPU
+enum class AssetResidency : int32_t
+{
+    KEEP = 0,
+    EVICT_AFTER_UPLOAD = 1,
+    // Kept until the CPU data of all assets exceeds the budget, the least recently uploaded gets released first
+    EVICT_UNDER_PRESSURE = 2
+};
+
+// Released data is loaded again from the caches on the worker threads when it is needed, e.g. for a re-upload
+// after the GPU copy got evicted or for saving the scene. Stored as ints so they can be edited as properties.
+struct ResidencyPolicy
+{
+    ResidencyPolicy() :
+        meshResidency(static_cast<int32_t>(AssetResidency::EVICT_AFTER_UPLOAD)),
+        textureResidency(static_cast<int32_t>(AssetResidency::EVICT_AFTER_UPLOAD)), cpuMemoryBudget(512)
+    {
+    }
+
+    int32_t meshResidency;
+    int32_t textureResidency;
+    // In MiB, only applies to EVICT_UNDER_PRESSURE
+    int32_t cpuMemoryBudget;
+
+    AssetResidency GetMeshResidency() const { return toResidency(meshResidency); }
+    AssetResidency GetTextureResidency() const { return toResidency(textureResidency); }
+    size_t GetCpuMemoryBudget() const { return static_cast<size_t>(std::max(cpuMemoryBudget, 0)) * 1024 * 1024; }
+
+    nlohmann::ordered_json SerializeObject() const
+    {
+        return {
+            {"MeshResidency", meshResidency},
+            {"TextureResidency", textureResidency},
+            {"CpuMemoryBudget", cpuMemoryBudget}
+        };
+    }
+    void DeSerializeObject(nlohmann::json jsonObject)
+    {
+        meshResidency = jsonObject["MeshResidency"];
+        textureResidency = jsonObject["TextureResidency"];
+        cpuMemoryBudget = jsonObject["CpuMemoryBudget"];
+    }
+
+private:
+    static AssetResidency toResidency(const int32_t residency)
+    {
+        return static_cast<AssetResidency>(std::clamp(residency, 0, static_cast<int32_t>(AssetResidency::EVICT_UNDER_PRESSURE)));
+    }
+};
@@ -2,17 +2,15 @@
 
 #include "AssetManager.h"
 
-TextureAsset::TextureAsset(const uint32_t id, const std::string& path, bool flipVertical, bool loadOnlyOneChannel, int channelIndex) :
-    m_Id(id), m_TextureData(nullptr), m_FlipVertical(flipVertical), m_LoadOnlyOneChannel(loadOnlyOneChannel), m_Width(0),
-    m_Height(0), m_NrComponents(0), m_ChannelIndex(channelIndex), m_Path(path), m_IsUnloaded(true)
+TextureAsset::TextureAsset(const uint32_t id, const std::string& path, bool flipVertical, bool loadOnlyOneChannel, int channelIndex,
+                           MaterialTextureSlot slot) :
+    m_Id(id), m_FlipVertical(flipVertical), m_LoadOnlyOneChannel(loadOnlyOneChannel), m_Width(0),
+    m_Height(0), m_NrComponents(0), m_ChannelIndex(channelIndex), m_Path(path), m_Slot(slot), m_CompressionFormat(BlockCompression::Format::NONE),
+    m_IsUnloaded(true), m_IsLoading(false), m_LoadTime(0)
 {
 }
 
-TextureAsset::~TextureAsset()
-{
-    if (!m_IsUnloaded)
-        delete[] m_TextureData;
-}
+TextureAsset::~TextureAsset() = default;
 
 uint32_t TextureAsset::GetId() const
 {
@@ -21,16 +19,27 @@ uint32_t TextureAsset::GetId() const
 
 unsigned char* TextureAsset::GetTextureData() const
 {
-    return m_TextureData;
+    return m_TextureData.GetData();
+}
+
+void TextureAsset::SetTextureData(PixelBuffer&& textureData)
+{
+    if (!m_IsUnloaded)
+        UnloadData();
+    m_TextureData = std::move(textureData);
+
+    m_IsUnloaded = false;
 }
 
-void TextureAsset::SetTextureData(const unsigned char* const textureData)
+void TextureAsset::SetCompressedData(BlockCompression::Format format, PixelBuffer&& data,
+                                     std::vector<TextureMipLevel>&& mipLevels)
 {
     if (!m_IsUnloaded)
-        delete[] m_TextureData;
-    const size_t dataSize = sizeof(unsigned char) * m_Width * m_Height * m_NrComponents;
-    m_TextureData = new unsigned char[dataSize];
-    memcpy(m_TextureData, textureData, dataSize);
+        UnloadData();
+
+    m_CompressionFormat = format;
+    m_CompressedData = std::move(data);
+    m_MipLevels = std::move(mipLevels);
 
     m_IsUnloaded = false;
 }
@@ -77,16 +86,13 @@ bool TextureAsset::isUnloaded() const
 
 void TextureAsset::UnloadData()
 {
-    delete[] m_TextureData;
+    m_TextureData.Reset();
+    m_CompressionFormat = BlockCompression::Format::NONE;
+    m_CompressedData.Reset();
+    m_MipLevels = {};
     m_IsUnloaded = true;
 }
 
-void TextureAsset::ReloadData()
-{
-    AssetManager::GetInstance().ReloadTexture(this);
-    m_IsUnloaded = false;
-}
-
 std::vector<std::pair<std::string, Property>> TextureAsset::GetAssetProperties()
 {
     std::vector<std::pair<std::string, Property>> returnVector;
@@ -103,7 +109,8 @@ nlohmann::ordered_json TextureAsset::SerializeObject()
         {"Height", m_Height},
         {"LoadOnlyOneChannel", m_LoadOnlyOneChannel},
         {"NrComponents", m_NrComponents},
-        {"ChannelIndex", m_ChannelIndex}
+        {"ChannelIndex", m_ChannelIndex},
+        {"Slot", m_Slot}
     };
 
     return texture;
@@ -116,5 +123,7 @@ void TextureAsset::DeSerializeObject(nlohmann::json jsonObject)
     m_NrComponents = jsonObject["NrComponents"];
     m_LoadOnlyOneChannel = jsonObject["LoadOnlyOneChannel"];
     m_ChannelIndex = jsonObject["ChannelIndex"];
-    ReloadData();
+    if (jsonObject.contains("Slot"))
+        m_Slot = jsonObject["Slot"];
+    // The data is imported once something renders with the texture
 }
@@ -1,18 +1,47 @@
 #pragma once
 #include "Base.h"
+#include "Application/Util/BlockCompression.h"
+#include "Application/Util/PixelBuffer.h"
 #include "Entity/PropertyType.h"
 #include "json.hpp"
 
+#include <atomic>
+
+enum class MaterialTextureSlot
+{
+    DIFFUSE,
+    NORMAL,
+    METALLIC,
+    ROUGHNESS,
+    AO,
+    EMISSIVE,
+    NONE
+};
+
+struct TextureMipLevel
+{
+    int32_t Width, Height;
+    size_t Offset, Size;
+};
+
 class TextureAsset
 {
 public:
-    TextureAsset(const uint32_t id, const std::string& path, bool flipVertical, bool loadOnlyOneChannel, int channelIndex);
+    TextureAsset(const uint32_t id, const std::string& path, bool flipVertical, bool loadOnlyOneChannel, int channelIndex,
+                 MaterialTextureSlot slot = MaterialTextureSlot::NONE);
 
     ~TextureAsset();
 
     uint32_t GetId() const;
     unsigned char* GetTextureData() const;
-    void SetTextureData(const unsigned char* const textureData);
+    // Takes ownership of the pixel data, width, height and number of components have to be set before
+    void SetTextureData(PixelBuffer&& textureData);
+    // Replaces the raw texture data with a baked, block compressed mip chain
+    void SetCompressedData(BlockCompression::Format format, PixelBuffer&& data, std::vector<TextureMipLevel>&& mipLevels);
+    bool IsCompressed() const { return m_CompressionFormat != BlockCompression::Format::NONE; }
+    BlockCompression::Format GetCompressionFormat() const { return m_CompressionFormat; }
+    const PixelBuffer& GetCompressedData() const { return m_CompressedData; }
+    const std::vector<TextureMipLevel>& GetMipLevels() const { return m_MipLevels; }
     const bool& GetFlipVertical() const;
     const bool& GetLoadOnlyOneChannel() const;
     int* GetWidth();
@@ -20,10 +49,17 @@ public:
     int* GetNrComponents();
     int* GetChannelIndex();
     std::string& GetPath();
+    MaterialTextureSlot GetSlot() const { return m_Slot; }
 
     bool isUnloaded() const;
+    bool IsLoading() const { return m_IsLoading.load(std::memory_order_acquire); }
+    void SetLoading(const bool isLoading) { m_IsLoading.store(isLoading, std::memory_order_release); }
     void UnloadData();
-    void ReloadData();
+    // Bytes of pixel data held on the CPU
+    size_t GetDataSize() const { return m_TextureData.GetSize() + m_CompressedData.GetSize(); }
+    // Microseconds the last import took (cache read or decode), textures decoded together share the time
+    int64_t GetLoadTime() const { return m_LoadTime; }
+    void SetLoadTime(const int64_t loadTime) { m_LoadTime = loadTime; }
 
     std::vector<std::pair<std::string, Property>> GetAssetProperties();
 
@@ -32,10 +68,16 @@ public:
 
 private:
     uint32_t m_Id;
-    unsigned char* m_TextureData;
+    PixelBuffer m_TextureData;
     bool m_FlipVertical, m_LoadOnlyOneChannel;
     int m_Width, m_Height, m_NrComponents, m_ChannelIndex;
     std::string m_Path;
+    MaterialTextureSlot m_Slot;
+    BlockCompression::Format m_CompressionFormat;
+    PixelBuffer m_CompressedData;
+    std::vector<TextureMipLevel> m_MipLevels;
 
     bool m_IsUnloaded;
+    std::atomic<bool> m_IsLoading;
+    int64_t m_LoadTime;
 };
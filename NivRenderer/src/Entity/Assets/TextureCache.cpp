@@ -0,0 +1,228 @@
+#include "Entity/Assets/TextureCache.h"
+
+#include <cstring>
+
+#include "Application/Util/FileUtils.h"
+#include "Application/Util/ImageUtils.h"
+
+TextureCache::TextureCache(const std::string& cacheDirectory) : m_CacheDirectory(cacheDirectory)
+{
+}
+
+bool TextureCache::Read(TextureAsset* textureAsset, const TextureSizePolicy& sizePolicy) const
+{
+    std::ifstream stream(getCacheFilePath(textureAsset), std::ios::binary);
+    if (!stream.is_open())
+        return false;
+
+    char identifier[sizeof(CACHE_IDENTIFIER)];
+    uint32_t version;
+    if (!stream.read(identifier, sizeof(identifier)) || std::memcmp(identifier, CACHE_IDENTIFIER, sizeof(identifier)) != 0 ||
+        !FileUtils::ReadValue(stream, version) || version != CACHE_VERSION)
+        return false;
+
+    std::string sourcePath;
+    int64_t sourceTimestamp;
+    bool flipVertical, loadOnlyOneChannel;
+    int32_t channelIndex, maxDimension;
+    bool roundToPowerOfTwo;
+    if (!FileUtils::ReadString(stream, sourcePath) || !FileUtils::ReadValue(stream, sourceTimestamp) ||
+        !FileUtils::ReadValue(stream, flipVertical) || !FileUtils::ReadValue(stream, loadOnlyOneChannel) ||
+        !FileUtils::ReadValue(stream, channelIndex) || !FileUtils::ReadValue(stream, maxDimension) ||
+        !FileUtils::ReadValue(stream, roundToPowerOfTwo))
+        return false;
+
+    // A changed size policy needs a rebake as well
+    if (sourcePath != textureAsset->GetPath() || sourceTimestamp != FileUtils::GetLastWriteTime(sourcePath) ||
+        flipVertical != textureAsset->GetFlipVertical() || loadOnlyOneChannel != textureAsset->GetLoadOnlyOneChannel() ||
+        (loadOnlyOneChannel && channelIndex != *textureAsset->GetChannelIndex()) ||
+        maxDimension != sizePolicy.GetMaxDimension(textureAsset->GetSlot()) ||
+        roundToPowerOfTwo != sizePolicy.roundToPowerOfTwo)
+        return false;
+
+    BlockCompression::Format format;
+    int32_t width, height, nrComponents;
+    std::vector<TextureMipLevel> mipLevels;
+    uint32_t dataSize;
+    if (!FileUtils::ReadValue(stream, format) || !FileUtils::ReadValue(stream, width) ||
+        !FileUtils::ReadValue(stream, height) || !FileUtils::ReadValue(stream, nrComponents) ||
+        !FileUtils::ReadVector(stream, mipLevels) || !FileUtils::ReadValue(stream, dataSize))
+        return false;
+
+    // Read straight into a pooled buffer, which gets handed to the texture without another copy
+    PixelBuffer data = PixelBuffer::Allocate(dataSize);
+    if (!stream.read(reinterpret_cast<char*>(data.GetData()), dataSize))
+        return false;
+
+    for (const auto& mipLevel : mipLevels)
+    {
+        if (mipLevel.Offset + mipLevel.Size > data.GetSize())
+            return false;
+    }
+    if (mipLevels.empty())
+        return false;
+
+    *textureAsset->GetWidth() = width;
+    *textureAsset->GetHeight() = height;
+    *textureAsset->GetNrComponents() = nrComponents;
+    textureAsset->SetCompressedData(format, std::move(data), std::move(mipLevels));
+
+    return true;
+}
+
+void TextureCache::Write(TextureAsset* textureAsset, const TextureSizePolicy& sizePolicy) const
+{
+    if (!textureAsset->IsCompressed())
+        return;
+
+    std::error_code errorCode;
+    std::filesystem::create_directories(m_CacheDirectory, errorCode);
+
+    const std::string cacheFilePath = getCacheFilePath(textureAsset);
+    const bool written = FileUtils::WriteFileAtomic(cacheFilePath, [&](std::ofstream& stream) {
+        stream.write(CACHE_IDENTIFIER, sizeof(CACHE_IDENTIFIER));
+        FileUtils::WriteValue(stream, CACHE_VERSION);
+        FileUtils::WriteString(stream, textureAsset->GetPath());
+        FileUtils::WriteValue(stream, FileUtils::GetLastWriteTime(textureAsset->GetPath()));
+        FileUtils::WriteValue(stream, textureAsset->GetFlipVertical());
+        FileUtils::WriteValue(stream, textureAsset->GetLoadOnlyOneChannel());
+        FileUtils::WriteValue(stream, static_cast<int32_t>(*textureAsset->GetChannelIndex()));
+        FileUtils::WriteValue(stream, sizePolicy.GetMaxDimension(textureAsset->GetSlot()));
+        FileUtils::WriteValue(stream, sizePolicy.roundToPowerOfTwo);
+        FileUtils::WriteValue(stream, textureAsset->GetCompressionFormat());
+        FileUtils::WriteValue(stream, static_cast<int32_t>(*textureAsset->GetWidth()));
+        FileUtils::WriteValue(stream, static_cast<int32_t>(*textureAsset->GetHeight()));
+        FileUtils::WriteValue(stream, static_cast<int32_t>(*textureAsset->GetNrComponents()));
+        FileUtils::WriteVector(stream, textureAsset->GetMipLevels());
+        const PixelBuffer& data = textureAsset->GetCompressedData();
+        FileUtils::WriteValue(stream, static_cast<uint32_t>(data.GetSize()));
+        stream.write(reinterpret_cast<const char*>(data.GetData()), static_cast<std::streamsize>(data.GetSize()));
+    });
+    if (!written)
+        SPDLOG_DEBUG("Could not write texture cache " + cacheFilePath);
+}
+
+bool TextureCache::Read(EnvironmentMap* environmentMap) const
+{
+    std::ifstream stream(getCacheFilePath(environmentMap), std::ios::binary);
+    if (!stream.is_open())
+        return false;
+
+    char identifier[sizeof(CACHE_IDENTIFIER)];
+    uint32_t version;
+    if (!stream.read(identifier, sizeof(identifier)) || std::memcmp(identifier, CACHE_IDENTIFIER, sizeof(identifier)) != 0 ||
+        !FileUtils::ReadValue(stream, version) || version != CACHE_VERSION)
+        return false;
+
+    std::string sourcePath;
+    int64_t sourceTimestamp;
+    int32_t faceSize;
+    std::vector<TextureMipLevel> mipLevels;
+    uint32_t dataSize;
+    if (!FileUtils::ReadString(stream, sourcePath) || !FileUtils::ReadValue(stream, sourceTimestamp) ||
+        sourcePath != environmentMap->GetPath() || sourceTimestamp != FileUtils::GetLastWriteTime(sourcePath) ||
+        !FileUtils::ReadValue(stream, faceSize) || !FileUtils::ReadVector(stream, mipLevels) ||
+        !FileUtils::ReadValue(stream, dataSize))
+        return false;
+
+    PixelBuffer data = PixelBuffer::Allocate(dataSize);
+    if (!stream.read(reinterpret_cast<char*>(data.GetData()), dataSize))
+        return false;
+
+    for (const auto& mipLevel : mipLevels)
+    {
+        if (mipLevel.Offset + mipLevel.Size > data.GetSize())
+            return false;
+    }
+    if (mipLevels.empty() || faceSize <= 0)
+        return false;
+
+    environmentMap->SetData(faceSize, std::move(data), std::move(mipLevels));
+
+    return true;
+}
+
+void TextureCache::Write(const EnvironmentMap* environmentMap) const
+{
+    if (!environmentMap->HasData())
+        return;
+
+    std::error_code errorCode;
+    std::filesystem::create_directories(m_CacheDirectory, errorCode);
+
+    const std::string cacheFilePath = getCacheFilePath(environmentMap);
+    const bool written = FileUtils::WriteFileAtomic(cacheFilePath, [&](std::ofstream& stream) {
+        stream.write(CACHE_IDENTIFIER, sizeof(CACHE_IDENTIFIER));
+        FileUtils::WriteValue(stream, CACHE_VERSION);
+        FileUtils::WriteString(stream, environmentMap->GetPath());
+        FileUtils::WriteValue(stream, FileUtils::GetLastWriteTime(environmentMap->GetPath()));
+        FileUtils::WriteValue(stream, environmentMap->GetFaceSize());
+        FileUtils::WriteVector(stream, environmentMap->GetMipLevels());
+        const PixelBuffer& data = environmentMap->GetData();
+        FileUtils::WriteValue(stream, static_cast<uint32_t>(data.GetSize()));
+        stream.write(reinterpret_cast<const char*>(data.GetData()), static_cast<std::streamsize>(data.GetSize()));
+    });
+    if (!written)
+        SPDLOG_DEBUG("Could not write texture cache " + cacheFilePath);
+}
+
+void TextureCache::Bake(TextureAsset* textureAsset)
+{
+    if (!textureAsset->GetTextureData() || *textureAsset->GetWidth() <= 0 || *textureAsset->GetHeight() <= 0)
+        return;
+
+    const int32_t nrComponents = *textureAsset->GetNrComponents();
+    const BlockCompression::Format format = BlockCompression::ChooseFormat(nrComponents);
+
+    int32_t width = *textureAsset->GetWidth();
+    int32_t height = *textureAsset->GetHeight();
+    size_t totalSize = 0;
+    for (int32_t mipWidth = width, mipHeight = height;; mipWidth = std::max(1, mipWidth / 2), mipHeight = std::max(1, mipHeight / 2))
+    {
+        totalSize += BlockCompression::GetCompressedSize(format, mipWidth, mipHeight);
+        if (mipWidth == 1 && mipHeight == 1)
+            break;
+    }
+
+    PixelBuffer data = PixelBuffer::Allocate(totalSize);
+    std::vector<TextureMipLevel> mipLevels;
+    PixelBuffer currentLevel, nextLevel;
+    const unsigned char* levelData = textureAsset->GetTextureData();
+    size_t offset = 0;
+    while (true)
+    {
+        const size_t levelSize = BlockCompression::GetCompressedSize(format, width, height);
+        BlockCompression::CompressImage(format, levelData, width, height, nrComponents, data.GetData() + offset);
+        mipLevels.push_back({width, height, offset, levelSize});
+        offset += levelSize;
+
+        if (width == 1 && height == 1)
+            break;
+
+        const int32_t nextWidth = std::max(1, width / 2);
+        const int32_t nextHeight = std::max(1, height / 2);
+        nextLevel = PixelBuffer::Allocate(static_cast<size_t>(nextWidth) * nextHeight * nrComponents);
+        ImageUtils::DownsampleHalf(levelData, width, height, nrComponents, nextLevel.GetData(), nextWidth, nextHeight);
+        std::swap(currentLevel, nextLevel);
+        levelData = currentLevel.GetData();
+        width = nextWidth;
+        height = nextHeight;
+    }
+
+    textureAsset->SetCompressedData(format, std::move(data), std::move(mipLevels));
+}
+
+std::string TextureCache::getCacheFilePath(TextureAsset* textureAsset) const
+{
+    uint64_t hash = FileUtils::HashString(textureAsset->GetPath());
+    const int32_t variant[3] = {textureAsset->GetFlipVertical(), textureAsset->GetLoadOnlyOneChannel(),
+                                textureAsset->GetLoadOnlyOneChannel() ? *textureAsset->GetChannelIndex() : 0};
+    hash = FileUtils::HashFnv1a(variant, sizeof(variant), hash);
+
+    return m_CacheDirectory + '/' + FileUtils::ToHexString(hash) + ".ntx";
+}
+
+std::string TextureCache::getCacheFilePath(const EnvironmentMap* environmentMap) const
+{
+    return m_CacheDirectory + '/' + FileUtils::ToHexString(FileUtils::HashString(environmentMap->GetPath())) + ".nenv";
+}
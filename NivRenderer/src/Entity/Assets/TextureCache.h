@@ -0,0 +1,31 @@
+#pragma once
+#include "Base.h"
+#include "Entity/Assets/EnvironmentMap.h"
+#include "Entity/Assets/TextureAsset.h"
+#include "Entity/Assets/TextureSizePolicy.h"
+
+// On-disk cache of baked textures. Every entry is a KTX2-like container holding the full, block compressed
+// mip chain, so loading a texture is a single read without any decoding or mip generation.
+class TextureCache
+{
+public:
+    TextureCache(const std::string& cacheDirectory);
+
+    bool Read(TextureAsset* textureAsset, const TextureSizePolicy& sizePolicy) const;
+    void Write(TextureAsset* textureAsset, const TextureSizePolicy& sizePolicy) const;
+    // Environment maps keep their converted half float cube faces, so the HDR image is only projected once
+    bool Read(EnvironmentMap* environmentMap) const;
+    void Write(const EnvironmentMap* environmentMap) const;
+
+    // Generates the mip chain from the raw texture data and block compresses every level
+    static void Bake(TextureAsset* textureAsset);
+
+private:
+    static constexpr char CACHE_IDENTIFIER[12] = {'\xAB', 'N', 'T', 'X', ' ', '1', '0', '\xBB', '\r', '\n', '\x1A', '\n'};
+    static constexpr uint32_t CACHE_VERSION = 2;
+
+    std::string m_CacheDirectory;
+
+    std::string getCacheFilePath(TextureAsset* textureAsset) const;
+    std::string getCacheFilePath(const EnvironmentMap* environmentMap) const;
+};
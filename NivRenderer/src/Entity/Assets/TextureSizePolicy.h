@@ -0,0 +1,67 @@
+#pragma once
+#include "Base.h"
+#include "Entity/Assets/TextureAsset.h"
+
+#include <bit>
+
+// Project wide limits for imported textures. Textures above the limit are downscaled on import (keeping their
+// aspect ratio), so VRAM and load time can be traded against quality on purpose.
+struct TextureSizePolicy
+{
+    TextureSizePolicy() :
+        maxDimension(4096), roundToPowerOfTwo(false), slotMaxDimensions{0, 0, 2048, 2048, 2048, 0, 0}
+    {
+    }
+
+    int32_t maxDimension;
+    bool roundToPowerOfTwo;
+    // Extra cap per MaterialTextureSlot on top of maxDimension, 0 means no extra cap
+    std::array<int32_t, static_cast<size_t>(MaterialTextureSlot::NONE) + 1> slotMaxDimensions;
+
+    int32_t GetMaxDimension(const MaterialTextureSlot slot) const
+    {
+        const int32_t slotMaxDimension = slotMaxDimensions[static_cast<size_t>(slot)];
+        if (maxDimension <= 0)
+            return slotMaxDimension;
+        if (slotMaxDimension <= 0)
+            return maxDimension;
+        return std::min(maxDimension, slotMaxDimension);
+    }
+
+    // Never upscales. Power of two rounding goes down per side, so the aspect ratio is only kept approximately.
+    glm::ivec2 GetTargetSize(const int32_t width, const int32_t height, const MaterialTextureSlot slot) const
+    {
+        glm::ivec2 targetSize(width, height);
+        const int32_t limit = GetMaxDimension(slot);
+        if (limit > 0 && std::max(width, height) > limit)
+        {
+            const double scale = static_cast<double>(limit) / std::max(width, height);
+            targetSize.x = std::max(1, static_cast<int32_t>(std::lround(width * scale)));
+            targetSize.y = std::max(1, static_cast<int32_t>(std::lround(height * scale)));
+        }
+
+        if (roundToPowerOfTwo)
+        {
+            targetSize.x = static_cast<int32_t>(std::bit_floor(static_cast<uint32_t>(targetSize.x)));
+            targetSize.y = static_cast<int32_t>(std::bit_floor(static_cast<uint32_t>(targetSize.y)));
+        }
+
+        return targetSize;
+    }
+
+    nlohmann::ordered_json SerializeObject() const
+    {
+        return {
+            {"MaxDimension", maxDimension},
+            {"RoundToPowerOfTwo", roundToPowerOfTwo},
+            {"SlotMaxDimensions", slotMaxDimensions}
+        };
+    }
+    void DeSerializeObject(nlohmann::json jsonObject)
+    {
+        maxDimension = jsonObject["MaxDimension"];
+        roundToPowerOfTwo = jsonObject["RoundToPowerOfTwo"];
+        for (size_t i = 0; i < slotMaxDimensions.size() && i < jsonObject["SlotMaxDimensions"].size(); i++)
+            slotMaxDimensions[i] = jsonObject["SlotMaxDimensions"][i];
+    }
+};
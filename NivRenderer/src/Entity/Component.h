@@ -6,15 +6,19 @@
 class Component
 {
 public:
-    Component(const uint32_t id, const char* name) : m_Id(id), m_Name(name) {}
+    Component(const uint32_t id, const char* name) : m_Id(id), m_Name(name), m_Version(0) {}
     virtual ~Component() = default;
 
 	const char* GetName() const { return m_Name; }
     const uint32_t& GetId() const { return m_Id; }
+    // Registry wide counter value of the last write, see ECSRegistry::MarkChanged
+    uint64_t GetVersion() const { return m_Version; }
+    void SetVersion(const uint64_t version) { m_Version = version; }
 	virtual std::vector<std::pair<std::string, Property>> GetComponentProperties() = 0;
     virtual nlohmann::ordered_json SerializeObject() = 0;
 
 protected:
     uint32_t m_Id;
 	const char* m_Name;
+    uint64_t m_Version;
 };
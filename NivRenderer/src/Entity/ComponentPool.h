@@ -0,0 +1,128 @@
+#pragma once
+#include "Base.h"
+#include "Entity/Component.h"
+
+#include <span>
+
+// Lets the registry look up and remove components without knowing their type
+class ComponentPoolBase
+{
+public:
+    virtual ~ComponentPoolBase() = default;
+
+    virtual Component* GetComponent(uint32_t entityId) = 0;
+    virtual bool Contains(uint32_t entityId) const = 0;
+    virtual void Remove(uint32_t entityId) = 0;
+    virtual void Clear() = 0;
+    virtual size_t GetSize() const = 0;
+
+    // Entities whose component of this type was added, written or removed since the last ClearChanges, every entity
+    // is listed once. Removed entities stay in the list, so check that the component still exists.
+    std::span<const uint32_t> GetChangedEntityIds() const { return m_ChangedEntityIds; }
+
+    bool IsChanged(const uint32_t entityId) const
+    {
+        return entityId < m_ChangedFlags.size() && m_ChangedFlags[entityId];
+    }
+
+    void MarkChanged(const uint32_t entityId)
+    {
+        if (entityId >= m_ChangedFlags.size())
+            m_ChangedFlags.resize(static_cast<size_t>(entityId) + 1, 0);
+        if (m_ChangedFlags[entityId])
+            return;
+
+        m_ChangedFlags[entityId] = 1;
+        m_ChangedEntityIds.push_back(entityId);
+    }
+
+    void ClearChanges()
+    {
+        for (const uint32_t entityId : m_ChangedEntityIds)
+            m_ChangedFlags[entityId] = 0;
+        m_ChangedEntityIds.clear();
+    }
+
+private:
+    std::vector<uint32_t> m_ChangedEntityIds;
+    // Indexed by entity id
+    std::vector<uint8_t> m_ChangedFlags;
+};
+
+// All components of one type packed into a single array, with the id of the owning entity at the same index, so a
+// system can stream over them linearly. Entity ids come from the IdManager and are dense, so they index the slot
+// table directly. Removing swaps the last component into the hole, which means pointers to components of this type
+// are only valid until the next component of the same type gets added or removed.
+template <typename T>
+class ComponentPool : public ComponentPoolBase
+{
+public:
+    T* Add(const uint32_t entityId, const uint32_t componentId)
+    {
+        if (T* component = Get(entityId))
+            return component;
+
+        if (entityId >= m_Slots.size())
+            m_Slots.resize(static_cast<size_t>(entityId) + 1, INVALID_SLOT);
+        m_Slots[entityId] = static_cast<uint32_t>(m_Components.size());
+        m_EntityIds.push_back(entityId);
+        m_Components.emplace_back(componentId);
+
+        return &m_Components.back();
+    }
+
+    T* Get(const uint32_t entityId)
+    {
+        if (!Contains(entityId))
+            return nullptr;
+
+        return &m_Components[m_Slots[entityId]];
+    }
+
+    Component* GetComponent(const uint32_t entityId) override { return Get(entityId); }
+
+    bool Contains(const uint32_t entityId) const override
+    {
+        return entityId < m_Slots.size() && m_Slots[entityId] != INVALID_SLOT;
+    }
+
+    void Remove(const uint32_t entityId) override
+    {
+        if (!Contains(entityId))
+            return;
+
+        const uint32_t slot = m_Slots[entityId];
+        const uint32_t lastSlot = static_cast<uint32_t>(m_Components.size()) - 1;
+        if (slot != lastSlot)
+        {
+            m_Components[slot] = std::move(m_Components[lastSlot]);
+            m_EntityIds[slot] = m_EntityIds[lastSlot];
+            m_Slots[m_EntityIds[slot]] = slot;
+        }
+        m_Components.pop_back();
+        m_EntityIds.pop_back();
+        m_Slots[entityId] = INVALID_SLOT;
+    }
+
+    void Clear() override
+    {
+        m_Components.clear();
+        m_EntityIds.clear();
+        m_Slots.clear();
+        ClearChanges();
+    }
+
+    size_t GetSize() const override { return m_Components.size(); }
+
+    // Both in storage order, the entity at index i owns the component at index i
+    std::span<T> GetComponents() { return m_Components; }
+    std::span<const uint32_t> GetEntityIds() const { return m_EntityIds; }
+
+private:
+    static constexpr uint32_t INVALID_SLOT = UINT32_MAX;
+
+    std::vector<T> m_Components;
+    std::vector<uint32_t> m_EntityIds;
+    // Entity id -> index into the arrays above
+    std::vector<uint32_t> m_Slots;
+};
@@ -3,11 +3,21 @@
 #include "Entity/Assets/AssetManager.h"
 
 MaterialComponent::MaterialComponent(const uint32_t id) :
-    Component(id, "MaterialComponent"), m_MaterialAsset(nullptr)
+    Component(id, "MaterialComponent")
 {
     
 }
 
+MaterialAsset* MaterialComponent::GetMaterialAsset() const
+{
+    return AssetManager::GetInstance().GetMaterial(m_MaterialAsset);
+}
+
+void MaterialComponent::SetMaterialAsset(MaterialAsset* asset)
+{
+    m_MaterialAsset = asset ? AssetManager::GetInstance().GetMaterialHandle(asset->GetId()) : AssetHandle<MaterialAsset>();
+}
+
 std::vector<std::pair<std::string, Property>> MaterialComponent::GetComponentProperties()
 {
     std::vector<std::pair<std::string, Property>> returnVector;
@@ -23,7 +33,7 @@ nlohmann::ordered_json MaterialComponent::SerializeObject()
         {"Id", GetId()},
         {"Type", "MaterialComponent"},
         {"Name", GetName()},
-        {"MaterialAssetId", m_MaterialAsset->GetId()},
+        {"MaterialAssetId", m_MaterialAsset.id},
     };
 
     return component;
@@ -31,5 +41,5 @@ nlohmann::ordered_json MaterialComponent::SerializeObject()
 
 void MaterialComponent::DeSerializeObject(nlohmann::json jsonObject)
 {
-    m_MaterialAsset = AssetManager::GetInstance().GetMaterial(static_cast<uint32_t>(jsonObject["MaterialAssetId"]));
+    m_MaterialAsset = AssetManager::GetInstance().GetMaterialHandle(static_cast<uint32_t>(jsonObject["MaterialAssetId"]));
 }
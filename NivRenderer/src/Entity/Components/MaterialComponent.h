@@ -1,6 +1,7 @@
 #pragma once
 #include "Base.h"
 #include "Entity/Component.h"
+#include "Entity/Assets/AssetRegistry.h"
 #include "Entity/Assets/MaterialAsset.h"
 
 class MaterialComponent : public Component
@@ -11,12 +12,13 @@ public:
 
     std::vector<std::pair<std::string, Property>> GetComponentProperties() override;
 
-    MaterialAsset* GetMaterialAsset() const { return m_MaterialAsset; }
-    void SetMaterialAsset(MaterialAsset* asset) { m_MaterialAsset = asset; }
+    // nullptr if the material was removed or replaced since it was set
+    MaterialAsset* GetMaterialAsset() const;
+    void SetMaterialAsset(MaterialAsset* asset);
 
     nlohmann::ordered_json SerializeObject() override;
     void DeSerializeObject(nlohmann::json jsonObject);
 
 private:
-    MaterialAsset* m_MaterialAsset;
+    AssetHandle<MaterialAsset> m_MaterialAsset;
 };
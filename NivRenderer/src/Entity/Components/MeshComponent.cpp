@@ -8,7 +8,7 @@ MeshComponent::MeshComponent(const uint32_t id)
 
 MeshAsset* MeshComponent::GetMeshAsset() const
 {
-    return m_MeshAsset;
+    return AssetManager::GetInstance().GetMesh(m_MeshAsset);
 }
 
 std::string& MeshComponent::GetPath()
@@ -18,7 +18,7 @@ std::string& MeshComponent::GetPath()
 
 void MeshComponent::SetMeshAsset(MeshAsset* asset)
 {
-    m_MeshAsset = asset;
+    m_MeshAsset = asset ? AssetManager::GetInstance().GetMeshHandle(asset->GetId()) : AssetHandle<MeshAsset>();
 }
 
 std::vector<std::pair<std::string, Property>> MeshComponent::GetComponentProperties()
@@ -37,7 +37,7 @@ nlohmann::ordered_json MeshComponent::SerializeObject()
         {"Type", "MeshComponent"},
         {"Name", GetName()},
         {"Path", m_Path},
-        {"MeshAssetId", m_MeshAsset->GetId()},
+        {"MeshAssetId", m_MeshAsset.id},
     };
 
     return component;
@@ -46,10 +46,10 @@ nlohmann::ordered_json MeshComponent::SerializeObject()
 void MeshComponent::DeSerializeObject(nlohmann::json jsonObject)
 {
     m_Path = jsonObject["Path"];
-    m_MeshAsset = AssetManager::GetInstance().GetMesh(jsonObject["MeshAssetId"]);
+    m_MeshAsset = AssetManager::GetInstance().GetMeshHandle(jsonObject["MeshAssetId"]);
 }
 
 void MeshComponent::reloadMesh()
 {
-    m_MeshAsset = AssetManager::GetInstance().LoadMesh(m_Path);
+    SetMeshAsset(AssetManager::GetInstance().LoadMesh(m_Path));
 }
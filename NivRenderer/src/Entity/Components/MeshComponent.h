@@ -9,6 +9,7 @@ public:
     MeshComponent(const uint32_t id);
 	~MeshComponent() override = default;
 
+    // nullptr if the mesh was removed or replaced since it was set
     MeshAsset* GetMeshAsset() const;
     std::string& GetPath();
     void SetMeshAsset(MeshAsset* asset);
@@ -20,7 +21,7 @@ public:
 
 private:
 	std::string m_Path;
-    MeshAsset* m_MeshAsset;
+    AssetHandle<MeshAsset> m_MeshAsset;
 
     void reloadMesh();
 
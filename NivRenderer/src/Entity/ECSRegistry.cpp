@@ -1,5 +1,7 @@
 #include "ECSRegistry.h"
 
+#include <bit>
+
 void ECSRegistry::RemoveEntity(const uint32_t entityId)
 {
     doRemoveEntity(entityId, true);
@@ -8,33 +10,87 @@ void ECSRegistry::RemoveEntity(const uint32_t entityId)
 void ECSRegistry::ClearRegistry()
 {
     m_Entities.clear();
-    m_Components.clear();
-    m_EntityComponentsMap.clear();
+    m_StructureVersion++;
+    for (const auto& pool : m_ComponentPools)
+    {
+        if (pool)
+            pool->Clear();
+    }
 }
 
 void ECSRegistry::RemoveComponent(const uint32_t entityId, const uint32_t componentId)
 {
-    auto& componentVector = m_EntityComponentsMap[entityId].second;
-    componentVector.erase(std::ranges::remove_if(componentVector, 
-        [componentId](const Component* c) { return c->GetId() == componentId; }).begin(), componentVector.end());
-    m_Components.erase(componentId);
+    EntitySlot* slot = getSlot(entityId);
+    if (!slot)
+        return;
+
+    for (ComponentMask signature = slot->signature; signature; signature &= signature - 1)
+    {
+        const auto typeId = static_cast<uint32_t>(std::countr_zero(signature));
+        if (m_ComponentPools[typeId]->GetComponent(entityId)->GetId() == componentId)
+        {
+            m_ComponentPools[typeId]->Remove(entityId);
+            m_ComponentPools[typeId]->MarkChanged(entityId);
+            slot->signature &= ~(ComponentMask(1) << typeId);
+            m_StructureVersion++;
+            return;
+        }
+    }
 }
 
 std::vector<Component*> ECSRegistry::GetAllComponents(const uint32_t entityId)
 {
-    if (!m_EntityComponentsMap.contains(entityId))
+    const EntitySlot* slot = getSlot(entityId);
+    if (!slot)
 	{
         SPDLOG_DEBUG("Entity with ID " + std::to_string(entityId) + " not found!");
         return std::vector<Component*>();
 	}
 
-	return m_EntityComponentsMap[entityId].second;
+    std::vector<Component*> components;
+    for (ComponentMask signature = slot->signature; signature; signature &= signature - 1)
+    {
+        components.push_back(m_ComponentPools[std::countr_zero(signature)]->GetComponent(entityId));
+    }
+
+	return components;
+}
+
+void ECSRegistry::MarkChanged(const uint32_t entityId, Component* component)
+{
+    const EntitySlot* slot = getSlot(entityId);
+    if (!slot)
+        return;
+
+    for (ComponentMask signature = slot->signature; signature; signature &= signature - 1)
+    {
+        const auto typeId = static_cast<uint32_t>(std::countr_zero(signature));
+        if (m_ComponentPools[typeId]->GetComponent(entityId) == component)
+        {
+            component->SetVersion(++m_ChangeVersion);
+            m_ComponentPools[typeId]->MarkChanged(entityId);
+            return;
+        }
+    }
+}
+
+void ECSRegistry::ClearChanges()
+{
+    for (const auto& pool : m_ComponentPools)
+    {
+        if (pool)
+            pool->ClearChanges();
+    }
 }
 
 void ECSRegistry::doRemoveEntity(uint32_t entityId, bool deleteFromParent)
 {
+    EntitySlot* slot = getSlot(entityId);
+    if (!slot)
+        return;
+
     // Remove child entities
-    const auto entity = m_Entities[entityId].get();
+    const auto entity = slot->entity.get();
     for (const auto child : entity->GetChildEntities())
     {
         doRemoveEntity(child->GetId(), false);
@@ -42,15 +98,16 @@ void ECSRegistry::doRemoveEntity(uint32_t entityId, bool deleteFromParent)
 
     // Remove entity from parent
     if (deleteFromParent && entity->GetParentEntityId() != -1)
-        m_Entities[entity->GetParentEntityId()]->RemoveChildEntity(entityId);
+        m_Entities[entity->GetParentEntityId()].entity->RemoveChildEntity(entityId);
 
     // Remove attached Components
-    m_Entities.erase(entityId);
-    for (const auto component : m_EntityComponentsMap[entityId].second)
+    for (ComponentMask signature = slot->signature; signature; signature &= signature - 1)
     {
-        m_Components.erase(component->GetId());
+        m_ComponentPools[std::countr_zero(signature)]->Remove(entityId);
+        m_ComponentPools[std::countr_zero(signature)]->MarkChanged(entityId);
     }
 
     // Remove Entity itself
-    m_EntityComponentsMap.erase(entityId);
+    *slot = EntitySlot();
+    m_StructureVersion++;
 }
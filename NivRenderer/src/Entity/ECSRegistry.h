@@ -2,8 +2,15 @@
 #include "Base.h"
 #include "Entity/Entity.h"
 #include "Entity/Component.h"
+#include "Entity/ComponentPool.h"
+#include "Entity/TypeIds.h"
 #include "IdManager.h"
 
+#include <span>
+
+template<typename... Ts>
+class View;
+
 class ECSRegistry
 {
 public:
@@ -22,6 +29,7 @@ public:
     void RemoveComponent(const uint32_t entityId, const uint32_t componentId);
     std::vector<Component*> GetAllComponents(const uint32_t entityId);
 
+	// An entity has at most one component of every type, adding another one returns the existing component
 	template<typename T>
     T* AddComponent(const uint32_t entityId);
 
@@ -34,14 +42,77 @@ public:
 	template<typename T>
     T* GetComponent(const uint32_t entityId);
 
+    template<typename T>
+    bool HasComponent(const uint32_t entityId) const;
+
+    // Bit i is set if the entity has a component with the type id i, 0 for unknown entities
+    ComponentMask GetSignature(const uint32_t entityId) const
+    {
+        const EntitySlot* slot = getSlot(entityId);
+        return slot ? slot->signature : 0;
+    }
+
+    // Changes whenever an entity or component gets added or removed, cached query results compare against it
+    uint64_t GetStructureVersion() const { return m_StructureVersion; }
+
+    // Components are edited through raw pointers, so writes have to be reported. The component gets the next version
+    // and the entity is added to the change list of the component type. Adding and removing components counts as a
+    // change as well.
+    template<typename T>
+    void MarkChanged(const uint32_t entityId);
+    // For code that only knows the component base class, like the property editor
+    void MarkChanged(const uint32_t entityId, Component* component);
+
+    template<typename T>
+    std::span<const uint32_t> GetChangedEntityIds();
+
+    template<typename T>
+    bool IsChanged(const uint32_t entityId);
+
+    // The renderer is the consumer of the change lists and clears them at the end of its update
+    void ClearChanges();
+
+    // Every component of the type in storage order, GetComponentEntityIds<T>()[i] owns GetComponents<T>()[i]
+    template<typename T>
+    std::span<T> GetComponents();
+
+    template<typename T>
+    std::span<const uint32_t> GetComponentEntityIds();
+
 private:
-    ECSRegistry() = default;
+    ECSRegistry() : m_StructureVersion(0), m_ChangeVersion(0) {}
+
+    template<typename... Ts>
+    friend class View;
+
+    struct EntitySlot
+    {
+        Scope<Entity> entity;
+        EntityTypeMask typeMask = 0;
+        ComponentMask signature = 0;
+    };
 
     void doRemoveEntity(uint32_t entityId, bool deleteFromParent);
 
-	std::unordered_map<uint32_t, std::pair<Entity*, std::vector<Component*>>> m_EntityComponentsMap;
-    std::unordered_map<uint32_t, Scope<Entity>> m_Entities;
-    std::unordered_map<uint32_t, Scope<Component>> m_Components;
+    // Ids come from the IdManager and are dense, so they index the slots directly like in the AssetRegistry
+    EntitySlot* getSlot(const uint32_t entityId)
+    {
+        return entityId < m_Entities.size() && m_Entities[entityId].entity ? &m_Entities[entityId] : nullptr;
+    }
+    const EntitySlot* getSlot(const uint32_t entityId) const
+    {
+        return entityId < m_Entities.size() && m_Entities[entityId].entity ? &m_Entities[entityId] : nullptr;
+    }
+
+    template<typename T>
+    ComponentPool<T>& getPool();
+
+    std::vector<EntitySlot> m_Entities;
+    // Indexed by component type id, which are assigned in the order the types were first used. GetAllComponents
+    // returns the components in that order.
+    std::vector<Scope<ComponentPoolBase>> m_ComponentPools;
+    uint64_t m_StructureVersion;
+    uint64_t m_ChangeVersion;
 };
 
 // Template implementations
@@ -50,19 +121,24 @@ T* ECSRegistry::AddComponent(const uint32_t entityId)
 {
     static_assert(std::is_base_of_v<Component, T>);
 
-    if (!m_EntityComponentsMap.contains(entityId))
+    EntitySlot* slot = getSlot(entityId);
+    if (!slot)
     {
         SPDLOG_DEBUG("Entity with ID " + std::to_string(entityId) + " not found!");
         return nullptr;
     }
 
-    const uint32_t id = IdManager::GetInstance().CreateNewId();
-    m_Components[id] = CreateScope<T>(id);
-    Component* component = m_Components[id].get();
+    ComponentPool<T>& pool = getPool<T>();
+    if (slot->signature & TypeIds::GetComponentBit<T>())
+        return pool.Get(entityId);
 
-    m_EntityComponentsMap[entityId].second.push_back(component);
+    slot->signature |= TypeIds::GetComponentBit<T>();
+    m_StructureVersion++;
+    T* component = pool.Add(entityId, IdManager::GetInstance().CreateNewId());
+    component->SetVersion(++m_ChangeVersion);
+    pool.MarkChanged(entityId);
 
-    return static_cast<T*>(component);
+    return component;
 }
 
 template <typename T>
@@ -71,25 +147,34 @@ T* ECSRegistry::CreateEntity(const int32_t entityIdParent)
     static_assert(std::is_base_of_v<Entity, T>);
 
     const uint32_t id = IdManager::GetInstance().CreateNewId();
-    m_Entities[id] = CreateScope<T>(id);
-    Entity* entity = m_Entities[id].get();
-    m_EntityComponentsMap[id].first = entity;
-    m_EntityComponentsMap[id].second = std::vector<Component*>();
+    if (id >= m_Entities.size())
+        m_Entities.resize(static_cast<size_t>(id) + 1);
+
+    auto entity = CreateScope<T>(id);
+    T* entityPtr = entity.get();
+    m_Entities[id] = {std::move(entity), TypeIds::GetEntityTypeMask<T>(), 0};
+    m_StructureVersion++;
 
     if (entityIdParent != -1)
     {
-        m_Entities[entityIdParent]->AddChildEntity(entity);
+        m_Entities[entityIdParent].entity->AddChildEntity(entityPtr);
     }
 
-    return static_cast<T*>(entity);
+    return entityPtr;
 }
 
 template <typename T>
 T* ECSRegistry::GetEntity(uint32_t entityId)
 {
-    Entity* entity = m_EntityComponentsMap[entityId].first;
-    if (T* returnPtr = dynamic_cast<T*>(entity))
-        return returnPtr;
+    static_assert(std::is_base_of_v<Entity, T>);
+
+    if (const EntitySlot* slot = getSlot(entityId))
+    {
+        if constexpr (std::is_same_v<T, Entity>)
+            return slot->entity.get();
+        else if (slot->typeMask & TypeIds::GetEntityTypeBit<T>())
+            return static_cast<T*>(slot->entity.get());
+    }
 
     SPDLOG_DEBUG("Entity with ID " + std::to_string(entityId) + " not found!");
     return nullptr;
@@ -98,17 +183,72 @@ T* ECSRegistry::GetEntity(uint32_t entityId)
 template <typename T>
 T* ECSRegistry::GetComponent(const uint32_t entityId)
 {
-    if (!m_Entities.contains(entityId))
+    const EntitySlot* slot = getSlot(entityId);
+    if (!slot)
     {
         SPDLOG_DEBUG("Entity with ID " + std::to_string(entityId) + " not found!");
         return nullptr;
     }
 
-    for (Component* c : m_EntityComponentsMap[entityId].second)
+    if (!(slot->signature & TypeIds::GetComponentBit<T>()))
+        return nullptr;
+
+    return getPool<T>().Get(entityId);
+}
+
+template <typename T>
+bool ECSRegistry::HasComponent(const uint32_t entityId) const
+{
+    static_assert(std::is_base_of_v<Component, T>);
+
+    const EntitySlot* slot = getSlot(entityId);
+    return slot && (slot->signature & TypeIds::GetComponentBit<T>());
+}
+
+template <typename T>
+std::span<T> ECSRegistry::GetComponents()
+{
+    return getPool<T>().GetComponents();
+}
+
+template <typename T>
+std::span<const uint32_t> ECSRegistry::GetComponentEntityIds()
+{
+    return getPool<T>().GetEntityIds();
+}
+
+template <typename T>
+void ECSRegistry::MarkChanged(const uint32_t entityId)
+{
+    if (T* component = GetComponent<T>(entityId))
     {
-        if (T* returnPtr = dynamic_cast<T*>(c))
-            return returnPtr;
+        component->SetVersion(++m_ChangeVersion);
+        getPool<T>().MarkChanged(entityId);
     }
+}
 
-    return nullptr;
+template <typename T>
+std::span<const uint32_t> ECSRegistry::GetChangedEntityIds()
+{
+    return getPool<T>().GetChangedEntityIds();
+}
+
+template <typename T>
+bool ECSRegistry::IsChanged(const uint32_t entityId)
+{
+    return getPool<T>().IsChanged(entityId);
+}
+
+template <typename T>
+ComponentPool<T>& ECSRegistry::getPool()
+{
+    static_assert(std::is_base_of_v<Component, T>);
+
+    const uint32_t typeId = TypeIds::GetComponentTypeId<T>();
+    if (typeId >= m_ComponentPools.size())
+        m_ComponentPools.resize(static_cast<size_t>(typeId) + 1);
+    if (!m_ComponentPools[typeId])
+        m_ComponentPools[typeId] = CreateScope<ComponentPool<T>>();
+
+    return *static_cast<ComponentPool<T>*>(m_ComponentPools[typeId].get());
 }
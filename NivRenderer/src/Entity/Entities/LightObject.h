@@ -23,6 +23,8 @@ protected:
 class DirectionalLightObject : public LightObject
 {
 public:
+	using BaseEntity = LightObject;
+
 	DirectionalLightObject(uint32_t id) : LightObject(id, std::string("Directional Light")),
 		m_Direction(0.0f, -1.0f, 0.0f)
 	{}
@@ -68,6 +70,8 @@ private:
 class PointLightObject : public LightObject
 {
 public:
+	using BaseEntity = LightObject;
+
 	PointLightObject(uint32_t id) : LightObject(id, std::string("Point Light (") + std::to_string(id) + std::string(")")),
 		m_Position(0.0f, 0.0f, 0.0f), m_Strength(50)
 	{}
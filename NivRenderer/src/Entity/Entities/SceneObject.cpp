@@ -7,7 +7,8 @@
 #include "Application/Util/Math.h"
 
 SceneObject::SceneObject(uint32_t id)
-	: Entity(id, std::string("SceneObject (") + std::to_string(id) + std::string(")"))
+	: Entity(id, std::string("SceneObject (") + std::to_string(id) + std::string(")")),
+      m_ImportProfile(static_cast<int32_t>(ImportProfile::FULL_QUALITY))
 {
 }
 
@@ -28,18 +29,28 @@ void SceneObject::LoadModel()
         ECSRegistry::GetInstance().AddComponent<TransformComponent>(GetId());
     }
 
-    const auto model = AssetManager::GetInstance().LoadModel(m_ModelPath);
+    const auto model = AssetManager::GetInstance().LoadModel(m_ModelPath, static_cast<ImportProfile>(m_ImportProfile));
     m_EntityName = model->name;
     for (auto& subModel : model->subModels)
         createChildSceneObjectFromSubModel(subModel, GetId());
 }
 
+void SceneObject::ReimportModel()
+{
+    m_ImportProfile = std::clamp(m_ImportProfile, 0, static_cast<int32_t>(ImportProfile::OPTIMIZED_GLTF));
+    // Changed meshes are handed to the renderer by the next ProcessFileChanges, the child objects stay as they are
+    if (AssetManager::GetInstance().GetModel(m_ModelPath))
+        AssetManager::GetInstance().LoadModel(m_ModelPath, static_cast<ImportProfile>(m_ImportProfile));
+}
+
 std::vector<std::pair<std::string, Property>> SceneObject::GetEntityProperties()
 {
     std::vector<std::pair<std::string, Property>> returnVector;
 
     returnVector.push_back({"Model Name", {PropertyType::STRING, &m_EntityName, [this](){}}});
     returnVector.push_back({"Model Path", {PropertyType::PATH, &m_ModelPath, [this]() { LoadModel(); }}});
+    returnVector.push_back({"Import Profile (0 Full Quality, 1 Fast Preview, 2 Optimized glTF)",
+                            {PropertyType::INT, &m_ImportProfile, [this]() { ReimportModel(); }}});
 
     return returnVector;
 }
@@ -49,7 +60,8 @@ nlohmann::ordered_json SceneObject::SerializeObject()
     nlohmann::ordered_json object = {
         {"Id", m_EntityId},
         {"Name", m_EntityName},
-        {"ModelPath", m_ModelPath}
+        {"ModelPath", m_ModelPath},
+        {"ImportProfile", m_ImportProfile}
     };
 
     const auto components = ECSRegistry::GetInstance().GetAllComponents(m_EntityId);
@@ -83,6 +95,8 @@ void SceneObject::DeSerializeObject(nlohmann::json jsonObject)
 {
     m_EntityName = jsonObject["Name"];
     m_ModelPath = jsonObject["ModelPath"];
+    if (jsonObject.contains("ImportProfile"))
+        m_ImportProfile = jsonObject["ImportProfile"];
 
     if (jsonObject.contains("Components"))
     {
@@ -120,23 +134,24 @@ void SceneObject::DeSerializeObject(nlohmann::json jsonObject)
 
 void SceneObject::createChildSceneObjectFromSubModel(const SubModel& subModel, const uint32_t parentId)
 {
-    if (!subModel.mesh && subModel.subModels.empty())
+    MeshAsset* meshAsset = subModel.GetMesh();
+    if (!meshAsset && subModel.subModels.empty())
         return; // Empty node, not interesting for us
 
     const auto subObject = ECSRegistry::GetInstance().CreateEntity<SceneObject>(parentId);
     const auto transform = ECSRegistry::GetInstance().AddComponent<TransformComponent>(subObject->GetId());
 
-    if (subModel.mesh)
+    if (meshAsset)
     {
         const auto meshComponent = ECSRegistry::GetInstance().AddComponent<MeshComponent>(subObject->GetId());
-        meshComponent->SetMeshAsset(subModel.mesh);
-        const std::string meshPath = subModel.mesh->GetPath();
+        meshComponent->SetMeshAsset(meshAsset);
+        const std::string meshPath = meshAsset->GetPath();
         meshComponent->GetPath() = meshPath;
     }
-    if (subModel.material)
+    if (MaterialAsset* materialAsset = subModel.GetMaterial())
     {
         const auto materialComponent = ECSRegistry::GetInstance().AddComponent<MaterialComponent>(subObject->GetId());
-        materialComponent->SetMaterialAsset(subModel.material);
+        materialComponent->SetMaterialAsset(materialAsset);
     }
     *subObject->GetEntityName() = subModel.name;
 
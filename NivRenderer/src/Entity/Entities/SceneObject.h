@@ -12,6 +12,8 @@ public:
 
 	std::string *GetModelPath() { return &m_ModelPath; }
     void LoadModel();
+    // Imports the loaded model again with the current profile, its assets keep their identity
+    void ReimportModel();
 
     std::vector<std::pair<std::string, Property>> GetEntityProperties() override;
 
@@ -20,6 +22,8 @@ public:
 
 private:
     std::string m_ModelPath;
+    // ImportProfile, an int so it can be edited as a property
+    int32_t m_ImportProfile;
 
     static void createChildSceneObjectFromSubModel(const SubModel& subModel, const uint32_t parentId);
 
@@ -1,10 +1,25 @@
 #include "SkyboxObject.h"
+#include <cctype>
 #include <filesystem>
+#include <string_view>
 
 #include "Entity/Assets/AssetManager.h"
 
+namespace
+{
+    // Face names in the order of the cubemap faces: Right, Left, Top, Bottom, Front, Back
+    constexpr std::array<std::string_view, 6> FACE_SUFFIXES = {"_right", "_left", "_top", "_bottom", "_front", "_back"};
+
+    // A file belongs to a face if its name contains "_<Face>" followed by at least one more character
+    bool matchesFace(const std::string& lowerCaseFilename, const std::string_view suffix)
+    {
+        const size_t position = lowerCaseFilename.find(suffix);
+        return position != std::string::npos && position + suffix.size() < lowerCaseFilename.size();
+    }
+}
+
 SkyboxObject::SkyboxObject(uint32_t id) :
-    Entity(id, std::string("Skybox")), m_TextureAssets(), m_FlipTextures(false)
+    Entity(id, std::string("Skybox")), m_TextureAssets(), m_FlipTextures(false), m_EnvironmentMap(nullptr)
 {
 }
 
@@ -13,27 +28,25 @@ void SkyboxObject::SetTexturePathsFromFolder()
     //Assumes files are named "WHATEVER_Right.WHATEVER", "WHATEVER_Left.WHATEVER", etc.
     //Automatically populates Texture paths in the following order: Right, Left, Top, Bottom, Front, Back
 
+    if (m_TextureFolder.empty())
+        return;
     if (m_TextureFolder.back() != '/')
         m_TextureFolder += '/';
 
     namespace fs = std::filesystem;
-    for (const auto& entry : fs::directory_iterator(m_TextureFolder))
+    std::error_code errorCode;
+    for (const auto& entry : fs::directory_iterator(m_TextureFolder, errorCode))
     {
         std::string filename = entry.path().filename().string();
-        std::cmatch m;
-        if (std::regex_match(filename.c_str(), m, std::regex(R"(^.*_[R,r]ight..*$)")))
-            m_TexturePaths[0] = entry.path().string();
-        if (std::regex_match(filename.c_str(), m, std::regex(R"(^.*_[L,l]eft..*$)")))
-            m_TexturePaths[1] = entry.path().string();
-        if (std::regex_match(filename.c_str(), m, std::regex(R"(^.*_[T,t]op..*$)")))
-            m_TexturePaths[2] = entry.path().string();
-        if (std::regex_match(filename.c_str(), m, std::regex(R"(^.*_[B,b]ottom..*$)")))
-            m_TexturePaths[3] = entry.path().string();
-        if (std::regex_match(filename.c_str(), m, std::regex(R"(^.*_[F,f]ront..*$)")))
-            m_TexturePaths[4] = entry.path().string();
-        if (std::regex_match(filename.c_str(), m, std::regex(R"(^.*_[B,b]ack..*$)")))
-            m_TexturePaths[5] = entry.path().string();
+        std::ranges::transform(filename, filename.begin(), [](const unsigned char c) { return std::tolower(c); });
+        for (size_t i = 0; i < FACE_SUFFIXES.size(); i++)
+        {
+            if (matchesFace(filename, FACE_SUFFIXES[i]))
+                m_TexturePaths[i] = entry.path().string();
+        }
     }
+    if (errorCode)
+        SPDLOG_DEBUG("Could not read skybox folder " + m_TextureFolder + ": " + errorCode.message());
 
     bool allPathsSet = true;
     for (auto& path : GetTexturePaths())
@@ -49,10 +62,19 @@ void SkyboxObject::LoadTextures()
     uint8_t i = 0;
     for (auto& path : GetTexturePaths())
     {
+        // Every face is its own file, so they get decoded in parallel
         if (!path.empty())
-            m_TextureAssets[i] = AssetManager::GetInstance().LoadTexture(path, m_FlipTextures);
+            m_TextureAssets[i] = AssetManager::GetInstance().LoadTextureAsync(path, m_FlipTextures);
         i++;
     }
+    SetDirtyFlag(true);
+}
+
+void SkyboxObject::LoadEnvironmentMap()
+{
+    m_EnvironmentMap =
+        m_EnvironmentMapPath.empty() ? nullptr : AssetManager::GetInstance().LoadEnvironmentMapAsync(m_EnvironmentMapPath);
+    SetDirtyFlag(true);
 }
 
 bool SkyboxObject::HasAllTexturesSet()
@@ -71,9 +93,14 @@ std::vector<std::pair<std::string, Property>> SkyboxObject::GetEntityProperties(
     std::vector<std::pair<std::string, Property>> returnVector;
     returnVector.push_back({"Texture folder", {PropertyType::PATH, &m_TextureFolder, [this]()
     {
-        m_TextureFolder = std::regex_replace(m_TextureFolder, std::regex("\\\\"), R"(/)");
+        std::ranges::replace(m_TextureFolder, '\\', '/');
         SetTexturePathsFromFolder(); 
     }}});
+    returnVector.push_back({"Environment Map (HDR)", {PropertyType::PATH, &m_EnvironmentMapPath, [this]()
+    {
+        std::ranges::replace(m_EnvironmentMapPath, '\\', '/');
+        LoadEnvironmentMap();
+    }}});
     uint8_t i = 1;
     for (auto& path : m_TexturePaths)
     {
@@ -94,6 +121,7 @@ nlohmann::ordered_json SkyboxObject::SerializeObject()
         {"Name", m_EntityName},
         {"TextureFolder", m_TextureFolder},
         {"FlipTextures", m_FlipTextures},
+        {"EnvironmentMapPath", m_EnvironmentMapPath},
     };
 
     if (!m_TextureAssets.empty())
@@ -102,7 +130,7 @@ nlohmann::ordered_json SkyboxObject::SerializeObject()
         uint32_t i = 0;
         for (const auto& asset : m_TextureAssets)
         {
-            object["TextureAssets"][i] = asset->GetId();
+            object["TextureAssets"][i] = asset ? asset->GetId() : UINT32_MAX;
             i++;
         }
     }
@@ -140,6 +168,15 @@ void SkyboxObject::DeSerializeObject(nlohmann::json jsonObject)
     {
         uint32_t i = 0;
         for (const std::string& path : jsonObject["TexturePaths"])
+        {
             m_TexturePaths[i] = path;
+            i++;
+        }
+    }
+    if (jsonObject.contains("EnvironmentMapPath"))
+    {
+        m_EnvironmentMapPath = jsonObject["EnvironmentMapPath"];
+        if (!m_EnvironmentMapPath.empty())
+            LoadEnvironmentMap();
     }
 }
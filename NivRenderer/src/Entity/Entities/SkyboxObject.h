@@ -1,6 +1,7 @@
 #pragma once
 #include "Base.h"
 #include "Entity/Entity.h"
+#include "Entity/Assets/EnvironmentMap.h"
 #include "Entity/Assets/TextureAsset.h"
 
 class SkyboxObject : public Entity
@@ -9,12 +10,17 @@ public:
     SkyboxObject(uint32_t id);
 
     void SetTexturePathsFromFolder();
+    // Faces are decoded on the worker threads, the proxy picks them up once all of them are ready
     void LoadTextures();
+    // An environment map replaces the six faces while it is set
+    void LoadEnvironmentMap();
 
     std::array<std::string, 6>& GetTexturePaths() { return m_TexturePaths; }
     std::string* GetTextureFolder() { return &m_TextureFolder; }
     bool* GetFlipTextures() { return &m_FlipTextures; }
     std::array<TextureAsset*, 6>& GetTextureAssets() { return m_TextureAssets; }
+    std::string* GetEnvironmentMapPath() { return &m_EnvironmentMapPath; }
+    EnvironmentMap* GetEnvironmentMap() const { return m_EnvironmentMap; }
     bool HasAllTexturesSet();
 
     std::vector<std::pair<std::string, Property>> GetEntityProperties() override;
@@ -27,4 +33,7 @@ private:
     std::array<std::string, 6> m_TexturePaths;
     std::array<TextureAsset*, 6> m_TextureAssets;
     bool m_FlipTextures;
+    // Equirectangular HDR image
+    std::string m_EnvironmentMapPath;
+    EnvironmentMap* m_EnvironmentMap;
 };
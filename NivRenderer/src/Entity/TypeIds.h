@@ -0,0 +1,68 @@
+#pragma once
+#include "Base.h"
+
+#include <cassert>
+
+// Component and entity types are numbered in the order they are first used, so a type lookup is an index into an
+// array and type checks are a bit test instead of a dynamic_cast. The numbers are not stable between runs and must
+// not be serialized.
+
+// One bit per component type, set for every component an entity has
+using ComponentMask = uint64_t;
+constexpr uint32_t MAX_COMPONENT_TYPES = 64;
+
+// One bit per entity type, set for the type of an entity and all of its entity base classes
+using EntityTypeMask = uint64_t;
+constexpr uint32_t MAX_ENTITY_TYPES = 64;
+
+namespace TypeIds
+{
+    // A type past the mask width would shift its bit out of the mask and match nothing
+    inline uint32_t NextComponentTypeId()
+    {
+        static uint32_t nextId = 0;
+        assert(nextId < MAX_COMPONENT_TYPES && "Too many component types for ComponentMask");
+        return nextId++;
+    }
+
+    inline uint32_t NextEntityTypeId()
+    {
+        static uint32_t nextId = 0;
+        assert(nextId < MAX_ENTITY_TYPES && "Too many entity types for EntityTypeMask");
+        return nextId++;
+    }
+
+    template <typename T>
+    uint32_t GetComponentTypeId()
+    {
+        static const uint32_t id = NextComponentTypeId();
+        return id;
+    }
+
+    template <typename T>
+    ComponentMask GetComponentBit()
+    {
+        return ComponentMask(1) << GetComponentTypeId<T>();
+    }
+
+    template <typename T>
+    EntityTypeMask GetEntityTypeBit()
+    {
+        static const EntityTypeMask bit = EntityTypeMask(1) << NextEntityTypeId();
+        return bit;
+    }
+
+    // Entity classes that derive from another entity class than Entity name it with "using BaseEntity = ...;", so
+    // the entity also counts as its base class (e.g. GetEntity<LightObject> on a DirectionalLightObject)
+    template <typename T>
+    EntityTypeMask GetEntityTypeMask()
+    {
+        if constexpr (requires { typename T::BaseEntity; })
+        {
+            static_assert(std::is_base_of_v<typename T::BaseEntity, T>);
+            return GetEntityTypeBit<T>() | GetEntityTypeMask<typename T::BaseEntity>();
+        }
+        else
+            return GetEntityTypeBit<T>();
+    }
+}
@@ -0,0 +1,111 @@
+#pragma once
+#include "Base.h"
+#include "Entity/ECSRegistry.h"
+
+#include <tuple>
+
+// Every entity that has all of the component types, in the storage order of the first type, so put the rarest type
+// first. Iterating yields (entity id, component references...):
+//
+//     for (auto [entityId, mesh, material] : View<MeshComponent, MaterialComponent>())
+//
+// A view reads the pools directly and is only valid until an entity or component gets added or removed, use a
+// Query to keep the result around.
+template <typename... Ts>
+class View
+{
+public:
+    static_assert(sizeof...(Ts) > 0 && (std::is_base_of_v<Component, Ts> && ...));
+
+    using Value = std::tuple<uint32_t, Ts&...>;
+
+    class Iterator
+    {
+    public:
+        Iterator(const View* view, const size_t index) : m_View(view), m_Index(index) { skipMismatches(); }
+
+        Value operator*() const { return m_View->Get(m_View->m_EntityIds[m_Index]); }
+        Iterator& operator++()
+        {
+            m_Index++;
+            skipMismatches();
+            return *this;
+        }
+        bool operator==(const Iterator& other) const { return m_Index == other.m_Index; }
+
+    private:
+        void skipMismatches()
+        {
+            while (m_Index < m_View->m_EntityIds.size() && !m_View->matches(m_View->m_EntityIds[m_Index]))
+                m_Index++;
+        }
+
+        const View* m_View;
+        size_t m_Index;
+    };
+
+    View() :
+        m_Registry(ECSRegistry::GetInstance()), m_Pools(&m_Registry.getPool<Ts>()...),
+        m_Mask((TypeIds::GetComponentBit<Ts>() | ...))
+    {
+        m_EntityIds = std::get<0>(m_Pools)->GetEntityIds();
+    }
+
+    Iterator begin() const { return Iterator(this, 0); }
+    Iterator end() const { return Iterator(this, m_EntityIds.size()); }
+
+    // The entity has to have all of the components
+    Value Get(const uint32_t entityId) const
+    {
+        return Value(entityId, *std::get<ComponentPool<Ts>*>(m_Pools)->Get(entityId)...);
+    }
+
+private:
+    bool matches(const uint32_t entityId) const
+    {
+        if constexpr (sizeof...(Ts) == 1)
+            return true;
+        else
+            return (m_Registry.GetSignature(entityId) & m_Mask) == m_Mask;
+    }
+
+    ECSRegistry& m_Registry;
+    std::tuple<ComponentPool<Ts>*...> m_Pools;
+    ComponentMask m_Mask;
+    std::span<const uint32_t> m_EntityIds;
+};
+
+// Caches the ids of the entities a View<Ts...> matches and only searches again after an entity or component was
+// added or removed. Meant to be kept by a system that iterates the same set every frame.
+template <typename... Ts>
+class Query
+{
+public:
+    Query() : m_StructureVersion(UINT64_MAX) {}
+
+    const std::vector<uint32_t>& GetEntityIds()
+    {
+        if (m_StructureVersion != ECSRegistry::GetInstance().GetStructureVersion())
+        {
+            m_EntityIds.clear();
+            for (const auto& value : View<Ts...>())
+                m_EntityIds.push_back(std::get<0>(value));
+            m_StructureVersion = ECSRegistry::GetInstance().GetStructureVersion();
+        }
+
+        return m_EntityIds;
+    }
+
+    // Calls fn(entityId, Ts&...) for every matching entity
+    template <typename Fn>
+    void Each(Fn&& fn)
+    {
+        const View<Ts...> view;
+        for (const uint32_t entityId : GetEntityIds())
+            std::apply(fn, view.Get(entityId));
+    }
+
+private:
+    std::vector<uint32_t> m_EntityIds;
+    uint64_t m_StructureVersion;
+};
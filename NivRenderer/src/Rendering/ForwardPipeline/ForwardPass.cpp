@@ -74,6 +74,10 @@ void ForwardPass::Run(Scene* scene, ProxyManager& proxyManager, CommandBuffer& c
         const auto& projection = camera->GetProjection();
         const auto viewProj = projection * view;
         const auto& viewPos = camera->GetPosition();
+        // Pixels covered by one unit at distance one, used to project the LOD errors to the screen
+        const float lodProjectionScale = 0.5f * static_cast<float>(m_OutputFramebuffer->GetHeight()) * projection[1][1];
+        const bool meshletCulling = scene->GetSceneSettings().meshletCulling;
+        std::vector<MeshIndexRange> visibleMeshletRanges;
 
         // Set Shadowmap uniforms
         const bool hasShadowMap = lightSpaceMatrix != glm::mat4(1.0f);
@@ -166,14 +170,38 @@ void ForwardPass::Run(Scene* scene, ProxyManager& proxyManager, CommandBuffer& c
                                                   glm::value_ptr(sceneObjectProxy->GetModelMatrix())};
 
                 const auto meshProxy = sceneObjectProxy->GetMeshProxy();
+                rendererState.BoundUniforms[1] = {m_PassShader->GetUniformLocation("vertexFormat"), UniformType::INT,
+                                                  &meshProxy->GetVertexFormat()};
+                rendererState.BoundUniforms[2] = {m_PassShader->GetUniformLocation("positionOffset"), UniformType::FLOAT3,
+                                                  glm::value_ptr(meshProxy->GetPositionOffset())};
+                rendererState.BoundUniforms[3] = {m_PassShader->GetUniformLocation("positionScale"), UniformType::FLOAT3,
+                                                  glm::value_ptr(meshProxy->GetPositionScale())};
 
                 if (meshProxy->GetIndexCount())
-                    commandBuffer.Submit({CommandType::DRAW_INDEXED, rendererState, meshProxy->GetIndexCount()});
+                {
+                    const glm::mat4& modelMatrix = sceneObjectProxy->GetModelMatrix();
+                    const MeshLodRange& lod =
+                        meshProxy->SelectLod(modelMatrix, viewPos, lodProjectionScale, LOD_MAX_ERROR_PIXELS);
+                    // Meshlets only exist for LOD 0
+                    if (lod.firstIndex == 0 && meshletCulling &&
+                        meshProxy->CullMeshlets(modelMatrix, viewProj, viewPos, visibleMeshletRanges))
+                    {
+                        for (const auto& range : visibleMeshletRanges)
+                            commandBuffer.Submit({CommandType::DRAW_INDEXED, rendererState, range.indexCount, range.firstIndex});
+                    }
+                    else
+                        commandBuffer.Submit({CommandType::DRAW_INDEXED, rendererState, lod.indexCount, lod.firstIndex});
+                }
                 else
                     commandBuffer.Submit({CommandType::DRAW, rendererState, meshProxy->GetVerticesCount()});
             }
         }
 
+        // The vertex format uniforms only exist in the pass shader
+        rendererState.BoundUniforms[1] = {};
+        rendererState.BoundUniforms[2] = {};
+        rendererState.BoundUniforms[3] = {};
+
         if (scene->GetSceneSettings().visualizeLights && pointLightIndex)
         {
             const auto lightVisualizeShader = AssetManager::GetInstance().LoadShader(
@@ -215,6 +243,8 @@ void ForwardPass::Run(Scene* scene, ProxyManager& proxyManager, CommandBuffer& c
                                                   glm::value_ptr(camera->GetView())};
                 rendererState.BoundUniforms[1] = {skyboxShader->GetUniformLocation("projection"), UniformType::FLOAT4X4,
                                                   glm::value_ptr(camera->GetProjection())};
+                rendererState.BoundUniforms[2] = {skyboxShader->GetUniformLocation("isHdr"), UniformType::INT,
+                                                  skyboxProxy->GetIsHdr()};
                 rendererState.BoundTextures[0] = {static_cast<int32_t>(skyboxProxy->GetTextureId()),
                     m_PassShader->GetUniformLocation("skybox")};
 
@@ -17,6 +17,9 @@ public:
     void Run(Scene* scene, ProxyManager& proxyManager, CommandBuffer& commandBuffer) override;
 
 private:
+    // Coarser LODs are used as long as their simplification error stays below this on screen
+    static constexpr float LOD_MAX_ERROR_PIXELS = 1.0f;
+
     Scope<Framebuffer> m_ShadowmapFramebuffer;
     Shader* m_ShadowmapShader;
 
@@ -121,7 +121,8 @@ void OpenGLRenderer3D::DrawFrame(const CommandBuffer& commandBuffer)
                 if (renderCommand.Type == CommandType::DRAW)
                     glDrawArrays(GL_TRIANGLES, 0, renderCommand.VertexIndexCount);
                 else if (renderCommand.Type == CommandType::DRAW_INDEXED)
-                    glDrawElements(GL_TRIANGLES, renderCommand.VertexIndexCount, GL_UNSIGNED_INT, nullptr);
+                    glDrawElements(GL_TRIANGLES, renderCommand.VertexIndexCount, GL_UNSIGNED_INT,
+                                   reinterpret_cast<const void*>(renderCommand.FirstIndex * sizeof(uint32_t)));
             break;   
         }
         }
@@ -53,3 +53,8 @@ TextureProxy** MaterialProxy::GetRoughnessTexturePtr() { return &m_RoughnessText
 TextureProxy** MaterialProxy::GetAOTexturePtr() { return &m_AOTexture; }
 
 TextureProxy** MaterialProxy::GetEmissiveTexturePtr() { return &m_EmissiveTexture; }
+
+std::array<TextureProxy*, 6> MaterialProxy::GetTextures() const
+{
+    return {m_DiffuseTexture, m_NormalTexture, m_MetallicTexture, m_RoughnessTexture, m_AOTexture, m_EmissiveTexture};
+}
\ No newline at end of file
@@ -23,6 +23,7 @@ public:
     TextureProxy** GetRoughnessTexturePtr();
     TextureProxy** GetAOTexturePtr();
     TextureProxy** GetEmissiveTexturePtr();
+    std::array<TextureProxy*, 6> GetTextures() const;
 
 private:
     TextureProxy* m_DiffuseTexture, *m_NormalTexture, *m_MetallicTexture, *m_RoughnessTexture, *m_AOTexture, *m_EmissiveTexture;
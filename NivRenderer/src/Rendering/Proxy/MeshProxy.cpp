@@ -1,7 +1,40 @@
 #include "MeshProxy.h"
 
+#include "Application/Util/MemoryTracker.h"
+#include "glm/gtc/packing.hpp"
+
+namespace
+{
+    glm::vec2 encodeOctahedral(const glm::vec3& vector)
+    {
+        const float length = std::abs(vector.x) + std::abs(vector.y) + std::abs(vector.z);
+        if (length == 0.0f)
+            return glm::vec2(0.0f);
+
+        const glm::vec3 n = vector / length;
+        if (n.z >= 0.0f)
+            return {n.x, n.y};
+        // The lower hemisphere is folded over the diagonals
+        return {(1.0f - std::abs(n.y)) * (n.x >= 0.0f ? 1.0f : -1.0f),
+                (1.0f - std::abs(n.x)) * (n.y >= 0.0f ? 1.0f : -1.0f)};
+    }
+
+    int16_t packSnorm16(const float value)
+    {
+        return static_cast<int16_t>(std::round(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+    }
+
+    uint16_t packUnorm16(const float value)
+    {
+        return static_cast<uint16_t>(std::round(std::clamp(value, 0.0f, 1.0f) * 65535.0f));
+    }
+}
+
+
 MeshProxy::MeshProxy(uint32_t id) :
-    Proxy(id), m_VertexArray(UINT32_MAX), m_VertexBuffer(UINT32_MAX), m_IndexBuffer(UINT32_MAX), m_VerticesCount(0), m_IndexCount(0)
+    Proxy(id), m_VertexArray(UINT32_MAX), m_VertexBuffer(UINT32_MAX), m_IndexBuffer(UINT32_MAX), m_VerticesCount(0), m_IndexCount(0),
+    m_VertexFormat(static_cast<int32_t>(MeshVertexFormat::FULL)), m_PositionOffset(0.0f), m_PositionScale(1.0f),
+    m_BoundsCenter(0.0f), m_BoundsRadius(0.0f)
 {
     glCreateVertexArrays(1, &m_VertexArray);
     glCreateBuffers(1, &m_VertexBuffer);
@@ -13,22 +46,88 @@ MeshProxy::~MeshProxy()
     glDeleteBuffers(1, &m_VertexBuffer);
     glDeleteBuffers(1, &m_IndexBuffer);
     glDeleteVertexArrays(1, &m_VertexArray);
+    MemoryTracker::GetInstance().Untrack("Meshes", GetId());
 }
 
-void MeshProxy::CreateBuffers(const MeshComponent* const mesh)
+bool MeshProxy::CreateBuffers(MeshAsset* const meshAsset)
 {
-    const auto& vertices = mesh->GetMeshAsset()->GetVertices();
-    const auto& indices = mesh->GetMeshAsset()->GetIndices();
+    if (meshAsset->IsLoading() || meshAsset->IsDataReleased())
+        return false;
+
+    const auto& vertices = meshAsset->GetVertices();
+    const auto& indices = meshAsset->GetIndices();
+    const auto& lods = meshAsset->GetLods();
+    m_Meshlets = meshAsset->GetMeshlets();
 
     m_IndexCount = indices.size();
     m_VerticesCount = vertices.size();
 
-    glNamedBufferData(m_VertexBuffer, vertices.size() * sizeof(MeshVertex), vertices.data(), GL_DYNAMIC_DRAW);
+    // All levels of detail go into one index buffer, LOD 0 first
+    m_Lods.clear();
+    m_Lods.push_back({0, m_IndexCount, 0.0f});
+    uint32_t totalIndexCount = m_IndexCount;
+    for (const auto& lod : lods)
+    {
+        m_Lods.push_back({totalIndexCount, static_cast<uint32_t>(lod.indices.size()), lod.error});
+        totalIndexCount += static_cast<uint32_t>(lod.indices.size());
+    }
     if (m_IndexCount)
-        glNamedBufferData(m_IndexBuffer, m_IndexCount * sizeof(uint32_t), indices.data(), GL_DYNAMIC_DRAW);
+    {
+        glNamedBufferData(m_IndexBuffer, totalIndexCount * sizeof(uint32_t), nullptr, GL_DYNAMIC_DRAW);
+        glNamedBufferSubData(m_IndexBuffer, 0, m_IndexCount * sizeof(uint32_t), indices.data());
+        for (size_t i = 0; i < lods.size(); i++)
+        {
+            glNamedBufferSubData(m_IndexBuffer, m_Lods[i + 1].firstIndex * sizeof(uint32_t),
+                                 m_Lods[i + 1].indexCount * sizeof(uint32_t), lods[i].indices.data());
+        }
+    }
+    glVertexArrayElementBuffer(m_VertexArray, m_IndexBuffer);
+
+    glm::vec3 minPosition(0.0f), maxPosition(0.0f);
+    if (!vertices.empty())
+    {
+        minPosition = maxPosition = vertices[0].Position;
+        for (const auto& vertex : vertices)
+        {
+            minPosition = glm::min(minPosition, vertex.Position);
+            maxPosition = glm::max(maxPosition, vertex.Position);
+        }
+    }
+    m_PositionOffset = minPosition;
+    m_PositionScale = maxPosition - minPosition;
+    m_BoundsCenter = (minPosition + maxPosition) * 0.5f;
+    m_BoundsRadius = glm::length(maxPosition - minPosition) * 0.5f;
+
+    m_VertexFormat = static_cast<int32_t>(meshAsset->GetVertexFormat());
+    if (meshAsset->GetVertexFormat() == MeshVertexFormat::PACKED)
+        setupPackedVertices(vertices);
+    else
+        setupFullVertices(vertices);
 
+    const size_t vertexSize =
+        meshAsset->GetVertexFormat() == MeshVertexFormat::PACKED ? sizeof(PackedMeshVertex) : sizeof(MeshVertex);
+    MemoryTracker::GetInstance().Track("Meshes", GetId(), meshAsset->GetPath(),
+                                       vertices.size() * vertexSize + totalIndexCount * sizeof(uint32_t));
+
+    AssetManager::GetInstance().OnMeshUploaded(meshAsset);
+
+    return true;
+}
+
+void MeshProxy::Bind() const
+{
+    glBindVertexArray(m_VertexArray);
+}
+
+void MeshProxy::Unbind()
+{
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void MeshProxy::setupFullVertices(const std::vector<MeshVertex>& vertices)
+{
+    glNamedBufferData(m_VertexBuffer, vertices.size() * sizeof(MeshVertex), vertices.data(), GL_DYNAMIC_DRAW);
     glVertexArrayVertexBuffer(m_VertexArray, 0, m_VertexBuffer, 0, sizeof(MeshVertex));
-    glVertexArrayElementBuffer(m_VertexArray, m_IndexBuffer);
 
     glEnableVertexArrayAttrib(m_VertexArray, 0);
     glEnableVertexArrayAttrib(m_VertexArray, 1);
@@ -49,12 +148,108 @@ void MeshProxy::CreateBuffers(const MeshComponent* const mesh)
     glVertexArrayAttribBinding(m_VertexArray, 4, 0);
 }
 
-void MeshProxy::Bind() const
+void MeshProxy::setupPackedVertices(const std::vector<MeshVertex>& vertices)
 {
-    glBindVertexArray(m_VertexArray);
+    const glm::vec3 inverseScale(m_PositionScale.x > 0.0f ? 1.0f / m_PositionScale.x : 0.0f,
+                                 m_PositionScale.y > 0.0f ? 1.0f / m_PositionScale.y : 0.0f,
+                                 m_PositionScale.z > 0.0f ? 1.0f / m_PositionScale.z : 0.0f);
+
+    std::vector<PackedMeshVertex> packedVertices(vertices.size());
+    for (size_t i = 0; i < vertices.size(); i++)
+    {
+        const MeshVertex& vertex = vertices[i];
+        PackedMeshVertex& packedVertex = packedVertices[i];
+
+        const glm::vec3 position = (vertex.Position - m_PositionOffset) * inverseScale;
+        packedVertex.Position[0] = packUnorm16(position.x);
+        packedVertex.Position[1] = packUnorm16(position.y);
+        packedVertex.Position[2] = packUnorm16(position.z);
+        // The shader rebuilds the bitangent as cross(normal, tangent) * sign
+        const bool flipBitangent = glm::dot(glm::cross(vertex.Normal, vertex.Tangent), vertex.Bitangent) < 0.0f;
+        packedVertex.BitangentSign = flipBitangent ? 0 : UINT16_MAX;
+
+        const glm::vec2 normal = encodeOctahedral(vertex.Normal);
+        const glm::vec2 tangent = encodeOctahedral(vertex.Tangent);
+        packedVertex.NormalTangent[0] = packSnorm16(normal.x);
+        packedVertex.NormalTangent[1] = packSnorm16(normal.y);
+        packedVertex.NormalTangent[2] = packSnorm16(tangent.x);
+        packedVertex.NormalTangent[3] = packSnorm16(tangent.y);
+
+        packedVertex.TexCoords[0] = glm::packHalf1x16(vertex.TexCoords.x);
+        packedVertex.TexCoords[1] = glm::packHalf1x16(vertex.TexCoords.y);
+    }
+
+    glNamedBufferData(m_VertexBuffer, packedVertices.size() * sizeof(PackedMeshVertex), packedVertices.data(),
+                      GL_DYNAMIC_DRAW);
+    glVertexArrayVertexBuffer(m_VertexArray, 0, m_VertexBuffer, 0, sizeof(PackedMeshVertex));
+
+    glEnableVertexArrayAttrib(m_VertexArray, 5);
+    glEnableVertexArrayAttrib(m_VertexArray, 6);
+    glEnableVertexArrayAttrib(m_VertexArray, 7);
+
+    glVertexArrayAttribFormat(m_VertexArray, 5, 4, GL_UNSIGNED_SHORT, GL_TRUE, offsetof(PackedMeshVertex, Position));
+    glVertexArrayAttribFormat(m_VertexArray, 6, 4, GL_SHORT, GL_TRUE, offsetof(PackedMeshVertex, NormalTangent));
+    glVertexArrayAttribFormat(m_VertexArray, 7, 2, GL_HALF_FLOAT, GL_FALSE, offsetof(PackedMeshVertex, TexCoords));
+
+    glVertexArrayAttribBinding(m_VertexArray, 5, 0);
+    glVertexArrayAttribBinding(m_VertexArray, 6, 0);
+    glVertexArrayAttribBinding(m_VertexArray, 7, 0);
 }
 
-void MeshProxy::Unbind()
+const MeshLodRange& MeshProxy::SelectLod(const glm::mat4& modelMatrix, const glm::vec3& viewPosition,
+                                         const float projectionScale, const float maxErrorPixels) const
 {
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    const float scale = std::max({glm::length(glm::vec3(modelMatrix[0])), glm::length(glm::vec3(modelMatrix[1])),
+                                  glm::length(glm::vec3(modelMatrix[2]))});
+    const glm::vec3 center(modelMatrix * glm::vec4(m_BoundsCenter, 1.0f));
+    // Distance to the closest point of the bounding sphere, inside of it the full detail is used
+    const float distance = glm::length(center - viewPosition) - m_BoundsRadius * scale;
+    if (distance <= 0.0f)
+        return m_Lods.front();
+
+    for (size_t i = m_Lods.size() - 1; i > 0; i--)
+    {
+        if (m_Lods[i].error * scale * projectionScale / distance <= maxErrorPixels)
+            return m_Lods[i];
+    }
+    return m_Lods.front();
+}
+
+bool MeshProxy::CullMeshlets(const glm::mat4& modelMatrix, const glm::mat4& viewProjection,
+                             const glm::vec3& viewPosition, std::vector<MeshIndexRange>& outRanges) const
+{
+    outRanges.clear();
+    if (m_Meshlets.empty())
+        return false;
+
+    // Frustum planes extracted from the model view projection matrix are in object space, like the meshlet bounds
+    const glm::mat4 modelViewProjection = viewProjection * modelMatrix;
+    const glm::vec4 rowX(modelViewProjection[0][0], modelViewProjection[1][0], modelViewProjection[2][0], modelViewProjection[3][0]);
+    const glm::vec4 rowY(modelViewProjection[0][1], modelViewProjection[1][1], modelViewProjection[2][1], modelViewProjection[3][1]);
+    const glm::vec4 rowZ(modelViewProjection[0][2], modelViewProjection[1][2], modelViewProjection[2][2], modelViewProjection[3][2]);
+    const glm::vec4 rowW(modelViewProjection[0][3], modelViewProjection[1][3], modelViewProjection[2][3], modelViewProjection[3][3]);
+    std::array<glm::vec4, 6> planes = {rowW + rowX, rowW - rowX, rowW + rowY, rowW - rowY, rowW + rowZ, rowW - rowZ};
+    for (auto& plane : planes)
+        plane /= glm::length(glm::vec3(plane));
+    const glm::vec3 objectViewPosition(glm::inverse(modelMatrix) * glm::vec4(viewPosition, 1.0f));
+
+    for (const Meshlet& meshlet : m_Meshlets)
+    {
+        bool visible = true;
+        for (const auto& plane : planes)
+            visible &= glm::dot(glm::vec3(plane), meshlet.Center) + plane.w >= -meshlet.Radius;
+
+        const glm::vec3 toMeshlet = meshlet.Center - objectViewPosition;
+        if (visible && meshlet.ConeCutoff < 1.0f)
+            visible = glm::dot(toMeshlet, meshlet.ConeAxis) < meshlet.ConeCutoff * glm::length(toMeshlet) + meshlet.Radius;
+        if (!visible)
+            continue;
+
+        if (!outRanges.empty() && outRanges.back().firstIndex + outRanges.back().indexCount == meshlet.FirstIndex)
+            outRanges.back().indexCount += meshlet.IndexCount;
+        else
+            outRanges.push_back({meshlet.FirstIndex, meshlet.IndexCount});
+    }
+
+    return true;
 }
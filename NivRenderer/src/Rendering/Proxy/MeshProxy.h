@@ -3,13 +3,29 @@
 #include "Rendering/Proxy/Proxy.h"
 #include "Entity/Components/MeshComponent.h"
 
+// Range of a level of detail in the index buffer, all levels share the vertex buffer
+struct MeshLodRange
+{
+    uint32_t firstIndex;
+    uint32_t indexCount;
+    float error;
+};
+
+struct MeshIndexRange
+{
+    uint32_t firstIndex;
+    uint32_t indexCount;
+};
+
 class MeshProxy : public Proxy
 {
 public:
     MeshProxy(uint32_t id);
     ~MeshProxy() override;
 
-    void CreateBuffers(const MeshComponent* const mesh);
+    // Can be called again to replace the buffers, e.g. after the mesh was reloaded. Returns false without touching
+    // the buffers while the data of the mesh is released or still being restored.
+    bool CreateBuffers(MeshAsset* const meshAsset);
 
     void Bind() const;
     static void Unbind();
@@ -17,9 +33,31 @@ public:
     uint32_t GetIndexCount() const { return m_IndexCount; }
     uint32_t GetVerticesCount() const { return m_VerticesCount; }
     uint32_t GetVertexArrayId() const { return m_VertexArray; }
+    // Bounds of the mesh, MeshVertexFormat::PACKED positions are decoded as offset + scale * quantized position
+    const int32_t& GetVertexFormat() const { return m_VertexFormat; }
+    const glm::vec3& GetPositionOffset() const { return m_PositionOffset; }
+    const glm::vec3& GetPositionScale() const { return m_PositionScale; }
+    // Picks the coarsest LOD whose error stays below maxErrorPixels on screen. projectionScale is the size in pixels
+    // of one unit at distance one, so (viewport height / 2) * projection[1][1] for a perspective projection.
+    const MeshLodRange& SelectLod(const glm::mat4& modelMatrix, const glm::vec3& viewPosition, float projectionScale,
+                                  float maxErrorPixels) const;
+    // Collects the LOD 0 index ranges of the meshlets that are inside the view frustum and not facing away from the
+    // camera, neighbouring visible meshlets are merged into one range. Returns false if the mesh has no meshlets.
+    bool CullMeshlets(const glm::mat4& modelMatrix, const glm::mat4& viewProjection, const glm::vec3& viewPosition,
+                      std::vector<MeshIndexRange>& outRanges) const;
 
 private:
     // TODO: Abstract
     uint32_t m_VertexArray, m_VertexBuffer, m_IndexBuffer;
     uint32_t m_IndexCount, m_VerticesCount;
+    // Stored as int, so it can be bound as a shader uniform directly
+    int32_t m_VertexFormat;
+    glm::vec3 m_PositionOffset, m_PositionScale;
+    std::vector<MeshLodRange> m_Lods;
+    std::vector<Meshlet> m_Meshlets;
+    glm::vec3 m_BoundsCenter;
+    float m_BoundsRadius;
+
+    void setupFullVertices(const std::vector<MeshVertex>& vertices);
+    void setupPackedVertices(const std::vector<MeshVertex>& vertices);
 };
\ No newline at end of file
@@ -2,12 +2,17 @@
 
 #include "Entity/ECSRegistry.h"
 #include "Entity/Components/MeshComponent.h"
-#include "Entity/Components/TransformComponent.h"
+#include "Application/Util/MemoryTracker.h"
 
-ProxyManager::ProxyManager() = default;
+#include <ranges>
+
+ProxyManager::ProxyManager() : m_FrameIndex(0) {}
 
 void ProxyManager::UpdateProxies(const Scene* const scene)
 {
+    m_FrameIndex++;
+    updateReloadingTextures();
+    updateReloadingMeshes();
     updateCameraProxy(scene->GetCameraId());
 
     if (scene->HasSkybox())
@@ -16,10 +21,108 @@ void ProxyManager::UpdateProxies(const Scene* const scene)
     for (const uint32_t sceneLightId : scene->GetSceneLightIds())
         updateSceneLightProxies(sceneLightId);
 
+    // Mesh and material are only resolved again for objects whose components changed, or whose entity was edited
+    ECSRegistry& registry = ECSRegistry::GetInstance();
+    for (const uint32_t sceneObjectId : registry.GetChangedEntityIds<MeshComponent>())
+        updateSceneObjectProxy(sceneObjectId);
+    for (const uint32_t sceneObjectId : registry.GetChangedEntityIds<MaterialComponent>())
+    {
+        if (!registry.IsChanged<MeshComponent>(sceneObjectId))
+            updateSceneObjectProxy(sceneObjectId);
+    }
+
+    // Parents come first, so the world matrices are ready before the proxies of the children read them
+    m_TransformHierarchy.Update(scene);
+    for (size_t node = 0; node < m_TransformHierarchy.GetSize(); node++)
+    {
+        const uint32_t sceneObjectId = m_TransformHierarchy.GetEntityId(node);
+        if (m_TransformHierarchy.GetEntity(node)->GetDirtyFlag() || !m_Proxies.contains(sceneObjectId))
+            updateSceneObjectProxy(sceneObjectId);
+
+        // Also set when only an ancestor moved, the mesh and material don't have to be looked at again then
+        if (m_TransformHierarchy.IsWorldMatrixChanged(node))
+        {
+            // Only SceneObjectProxies are stored under the id of a scene object
+            auto* sceneObjectProxy = static_cast<SceneObjectProxy*>(m_Proxies[sceneObjectId].get());
+            sceneObjectProxy->SetModelMatrix(m_TransformHierarchy.GetWorldMatrix(node));
+            sceneObjectProxy->GetDirtyFlag() = true;
+        }
+    }
+    // Meshes of the same model are restored with a single read of its cache entry
+    AssetManager::GetInstance().LoadMeshDataAsync(m_MeshesToLoad);
+    m_MeshesToLoad.clear();
+
     m_SceneObjectsToRender.clear();
     m_SceneObjectsToRenderByMaterial.clear();
-    for (const uint32_t sceneObjectId : scene->GetSceneObjectIds())
-        updateSceneObjectProxy(sceneObjectId, nullptr);
+    m_RenderableQuery.Each([this](const uint32_t entityId, const MeshComponent&, const MaterialComponent& material) {
+        const auto it = m_Proxies.find(entityId);
+        if (it == m_Proxies.end())
+            return;
+
+        // Not drawn until the data of its mesh is restored, or while its mesh or material is gone
+        const auto sceneObjectProxy = static_cast<SceneObjectProxy*>(it->second.get());
+        const MaterialAsset* materialAsset = material.GetMaterialAsset();
+        if (!sceneObjectProxy->GetMeshProxy() || !materialAsset)
+            return;
+        m_SceneObjectsToRender.push_back(sceneObjectProxy);
+        m_SceneObjectsToRenderByMaterial[materialAsset->GetId()].push_back(sceneObjectProxy);
+    });
+
+    // Textures are only loaded once a material gets drawn, the placeholders are bound until they are ready
+    for (const uint32_t materialId : m_SceneObjectsToRenderByMaterial | std::views::keys)
+        updateMaterialProxy(materialId);
+    if (const int32_t textureMemoryBudget = scene->GetSceneSettings().textureMemoryBudget; textureMemoryBudget > 0)
+        evictTextures(static_cast<size_t>(textureMemoryBudget) * 1024 * 1024);
+
+    registry.ClearChanges();
+}
+
+void ProxyManager::ReloadAssets(const Scene* const scene, const AssetChanges& assetChanges)
+{
+    for (const auto meshAsset : assetChanges.meshes)
+    {
+        const auto meshProxy = dynamic_cast<MeshProxy*>(GetProxy(meshAsset->GetId()));
+        if (meshProxy && !meshProxy->CreateBuffers(meshAsset))
+        {
+            // Released again in the meantime, the old buffers stay until the data is restored
+            if (std::ranges::find(m_ReloadingMeshes, meshAsset) == m_ReloadingMeshes.end())
+                m_ReloadingMeshes.push_back(meshAsset);
+            requestMeshData(meshAsset);
+        }
+    }
+    AssetManager::GetInstance().LoadMeshDataAsync(m_MeshesToLoad);
+    m_MeshesToLoad.clear();
+
+    std::vector<TextureAsset*> texturesToLoad;
+    for (const auto textureAsset : assetChanges.textures)
+    {
+        if (isTextureResident(textureAsset->GetId()) || textureAsset->IsLoading())
+        {
+            if (std::ranges::find(m_ReloadingTextures, textureAsset) == m_ReloadingTextures.end())
+                m_ReloadingTextures.push_back(textureAsset);
+            texturesToLoad.push_back(textureAsset);
+        }
+        else
+        {
+            // Not on the GPU, the next material that needs it imports it again
+            textureAsset->UnloadData();
+            m_RequestedTextureIds.erase(textureAsset->GetId());
+        }
+    }
+    AssetManager::GetInstance().LoadTexturesAsync(texturesToLoad);
+
+    if (scene->HasSkybox())
+    {
+        const auto skyboxObject = ECSRegistry::GetInstance().GetEntity<SkyboxObject>(scene->GetSkyboxObjectId());
+        for (const auto textureAsset : skyboxObject->GetTextureAssets())
+        {
+            if (textureAsset && std::ranges::find(assetChanges.textures, textureAsset) != assetChanges.textures.end())
+                skyboxObject->SetDirtyFlag(true);
+        }
+        if (std::ranges::find(assetChanges.environmentMaps, skyboxObject->GetEnvironmentMap()) !=
+            assetChanges.environmentMaps.end())
+            skyboxObject->SetDirtyFlag(true);
+    }
 }
 
 Proxy* ProxyManager::GetProxy(const uint32_t id)
@@ -40,80 +143,78 @@ std::unordered_map<uint32_t, std::vector<SceneObjectProxy*>> ProxyManager::GetSc
     return m_SceneObjectsToRenderByMaterial;
 }
 
-void ProxyManager::updateSceneObjectProxy(const uint32_t sceneObjectId, SceneObjectProxy* const parentProxy)
+void ProxyManager::updateSceneObjectProxy(const uint32_t sceneObjectId)
 {
+    // Removed objects stay in the change lists
     const auto sceneObject = ECSRegistry::GetInstance().GetEntity<SceneObject>(sceneObjectId);
+    if (!sceneObject)
+        return;
+
     const auto meshComponent = ECSRegistry::GetInstance().GetComponent<MeshComponent>(sceneObjectId);
-    const auto transformComponent = ECSRegistry::GetInstance().GetComponent<TransformComponent>(sceneObjectId);
     const auto materialComponent = ECSRegistry::GetInstance().GetComponent<MaterialComponent>(sceneObjectId);
 
-    const auto& childEntities = sceneObject->GetChildEntities();
-    if (sceneObject->GetDirtyFlag()) // Do we have to update the Proxy?
+    if (!m_Proxies.contains(sceneObjectId))
     {
-        for (const auto& childEntity : childEntities)
-            childEntity->SetDirtyFlag(true);
-
-        if (!m_Proxies.contains(sceneObjectId))
-        {
-            m_Proxies[sceneObjectId] = CreateScope<SceneObjectProxy>(sceneObjectId);
-        }
-        auto* sceneObjectProxy = dynamic_cast<SceneObjectProxy*>(m_Proxies[sceneObjectId].get());
+        m_Proxies[sceneObjectId] = CreateScope<SceneObjectProxy>(sceneObjectId);
+    }
+    auto* sceneObjectProxy = static_cast<SceneObjectProxy*>(m_Proxies[sceneObjectId].get());
 
-        if (meshComponent)
-        {
+    bool isMeshReady = true;
+    MeshAsset* meshAsset = meshComponent ? meshComponent->GetMeshAsset() : nullptr;
+    if (meshAsset)
+    {
+        MeshProxy* meshProxy = requestMeshProxy(meshAsset);
+        isMeshReady = meshProxy != nullptr;
+        sceneObjectProxy->SetMesh(meshProxy);
+    }
+    else
+    {
+        sceneObjectProxy->SetMesh(nullptr);
+    }
 
-            MeshProxy* meshProxy;
-            auto meshId = meshComponent->GetMeshAsset()->GetId();
-            if (!m_Proxies.contains(meshId))
-            {
-                m_Proxies[meshId] = CreateScope<MeshProxy>(meshId);
-                meshProxy = dynamic_cast<MeshProxy*>(m_Proxies[meshId].get());
-                meshProxy->CreateBuffers(meshComponent);
-            }
-            else
-            {
-                meshProxy = dynamic_cast<MeshProxy*>(m_Proxies[meshId].get());
-            }
+    const MaterialAsset* materialAsset = materialComponent ? materialComponent->GetMaterialAsset() : nullptr;
+    if (materialAsset)
+    {
+        const uint32_t materialId = materialAsset->GetId();
+        updateMaterialProxy(materialId);
+        sceneObjectProxy->SetMaterial(dynamic_cast<MaterialProxy*>(m_Proxies[materialId].get()));
+    }
+    else
+    {
+        sceneObjectProxy->SetMaterial(nullptr);
+    }
 
-            sceneObjectProxy->SetMesh(meshProxy);
-        }
-        else
-        {
-            sceneObjectProxy->SetMesh(nullptr);
-        }
+    // Stays dirty until the mesh is on the GPU, so the proxy is resolved again in the next frames
+    sceneObject->SetDirtyFlag(!isMeshReady);
+    sceneObjectProxy->GetDirtyFlag() = true;
+}
 
-        if (materialComponent)
-        {
-            const uint32_t materialId = materialComponent->GetMaterialAsset()->GetId();
-            updateMaterialProxy(materialId);
-            sceneObjectProxy->SetMaterial(dynamic_cast<MaterialProxy*>(m_Proxies[materialId].get()));
-        }
-        else
-        {
-            sceneObjectProxy->SetMaterial(nullptr);
-        }
+MeshProxy* ProxyManager::requestMeshProxy(MeshAsset* const meshAsset)
+{
+    const uint32_t meshId = meshAsset->GetId();
+    if (const auto it = m_Proxies.find(meshId); it != m_Proxies.end())
+        return static_cast<MeshProxy*>(it->second.get());
 
-        if (transformComponent)
-        {
-            sceneObjectProxy->SetTransform(transformComponent->GetPosition(), transformComponent->GetScale(), transformComponent->GetRotation());
-            if (parentProxy)
-            {
-                auto& modelMatrix = sceneObjectProxy->GetModelMatrix();
-                modelMatrix = parentProxy->GetModelMatrix() * modelMatrix;
-            }
-        }
-        
-        sceneObject->SetDirtyFlag(false);
-        sceneObjectProxy->GetDirtyFlag() = true;
+    // No GL objects are created before the data is there
+    if (meshAsset->IsLoading() || meshAsset->IsDataReleased())
+    {
+        requestMeshData(meshAsset);
+        return nullptr;
     }
 
-    for (const auto& childEntity : childEntities)
-        updateSceneObjectProxy(childEntity->GetId(), dynamic_cast<SceneObjectProxy*>(m_Proxies[sceneObjectId].get()));
+    m_Proxies[meshId] = CreateScope<MeshProxy>(meshId);
+    const auto meshProxy = static_cast<MeshProxy*>(m_Proxies[meshId].get());
+    meshProxy->CreateBuffers(meshAsset);
+    m_RequestedMeshIds.erase(meshId);
+    return meshProxy;
+}
 
-    if (meshComponent)
+void ProxyManager::requestMeshData(MeshAsset* const meshAsset)
+{
+    if (!meshAsset->IsLoading() && meshAsset->IsDataReleased() && !m_RequestedMeshIds.contains(meshAsset->GetId()))
     {
-        m_SceneObjectsToRender.push_back(dynamic_cast<SceneObjectProxy*>(m_Proxies[sceneObjectId].get()));
-        m_SceneObjectsToRenderByMaterial[materialComponent->GetMaterialAsset()->GetId()].push_back(dynamic_cast<SceneObjectProxy*>(m_Proxies[sceneObjectId].get()));
+        m_RequestedMeshIds.insert(meshAsset->GetId());
+        m_MeshesToLoad.push_back(meshAsset);
     }
 }
 
@@ -127,6 +228,17 @@ void ProxyManager::updateMaterialProxy(const uint32_t materialId)
     }
     const auto materialProxy = dynamic_cast<MaterialProxy*>(m_Proxies[materialId].get());
 
+    for (const auto textureProxy : materialProxy->GetTextures())
+    {
+        if (!textureProxy)
+            continue;
+
+        // Evicted textures have to be created again before the material can be drawn with them
+        if (!textureProxy->IsResident())
+            materialAsset->SetDirtyFlag(true);
+        textureProxy->SetLastUsedFrame(m_FrameIndex);
+    }
+
     if (!materialAsset->GetDirtyFlag())
         return;
 
@@ -134,20 +246,32 @@ void ProxyManager::updateMaterialProxy(const uint32_t materialId)
     const auto whiteTextureProxy = AssetManager::GetInstance().LoadTexture(whitePath, false);
     std::string blackPath("black");
     const auto blackTextureProxy = AssetManager::GetInstance().LoadTexture(blackPath, false);
-    setupMaterialProxy(materialAsset->GetDiffusePath(), materialProxy->GetDiffuseTexturePtr(),
-                       *materialAsset->GetDiffuseTextureAsset(), whiteTextureProxy);
-    setupMaterialProxy(materialAsset->GetNormalPath(), materialProxy->GetNormalTexturePtr(),
-                       *materialAsset->GetNormalTextureAsset(), nullptr);
-    setupMaterialProxy(materialAsset->GetMetallicPath(), materialProxy->GetMetallicTexturePtr(),
-                       *materialAsset->GetMetallicTextureAsset(), blackTextureProxy);
-    setupMaterialProxy(materialAsset->GetRoughnessPath(), materialProxy->GetRoughnessTexturePtr(),
-                       *materialAsset->GetRoughnessTextureAsset(), blackTextureProxy);
-    setupMaterialProxy(materialAsset->GetAOPath(), materialProxy->GetAOTexturePtr(),
-                       *materialAsset->GetAOTextureAsset(), whiteTextureProxy);
-    setupMaterialProxy(materialAsset->GetEmissivePath(), materialProxy->GetEmissiveTexturePtr(),
-                       *materialAsset->GetEmissiveTextureAsset(), blackTextureProxy);
-
-    materialAsset->SetDirtyFlag(false);
+    std::vector<TextureAsset*> texturesToLoad;
+    bool allTexturesReady = true;
+    allTexturesReady &= setupMaterialProxy(materialAsset->GetDiffusePath(), materialProxy->GetDiffuseTexturePtr(),
+                                           *materialAsset->GetDiffuseTextureAsset(), whiteTextureProxy,
+                                           MaterialTextureSlot::DIFFUSE, texturesToLoad);
+    allTexturesReady &= setupMaterialProxy(materialAsset->GetNormalPath(), materialProxy->GetNormalTexturePtr(),
+                                           *materialAsset->GetNormalTextureAsset(), nullptr,
+                                           MaterialTextureSlot::NORMAL, texturesToLoad);
+    allTexturesReady &= setupMaterialProxy(materialAsset->GetMetallicPath(), materialProxy->GetMetallicTexturePtr(),
+                                           *materialAsset->GetMetallicTextureAsset(), blackTextureProxy,
+                                           MaterialTextureSlot::METALLIC, texturesToLoad);
+    allTexturesReady &= setupMaterialProxy(materialAsset->GetRoughnessPath(), materialProxy->GetRoughnessTexturePtr(),
+                                           *materialAsset->GetRoughnessTextureAsset(), blackTextureProxy,
+                                           MaterialTextureSlot::ROUGHNESS, texturesToLoad);
+    allTexturesReady &= setupMaterialProxy(materialAsset->GetAOPath(), materialProxy->GetAOTexturePtr(),
+                                           *materialAsset->GetAOTextureAsset(), whiteTextureProxy,
+                                           MaterialTextureSlot::AO, texturesToLoad);
+    allTexturesReady &= setupMaterialProxy(materialAsset->GetEmissivePath(), materialProxy->GetEmissiveTexturePtr(),
+                                           *materialAsset->GetEmissiveTextureAsset(), blackTextureProxy,
+                                           MaterialTextureSlot::EMISSIVE, texturesToLoad);
+
+    // Channels of packed textures are requested together, so their source file is only decoded once
+    AssetManager::GetInstance().LoadTexturesAsync(texturesToLoad);
+
+    // Stay dirty until every texture finished decoding, so the placeholders get swapped out
+    materialAsset->SetDirtyFlag(!allTexturesReady);
 }
 
 void ProxyManager::updateCameraProxy(const uint32_t cameraId)
@@ -173,13 +297,93 @@ void ProxyManager::updateSkyboxProxy(const uint32_t skyboxId)
     }
     const auto skyboxProxy = dynamic_cast<SkyboxProxy*>(m_Proxies[skyboxId].get());
 
-    if (skyboxObject->HasAllTexturesSet())
+    if (EnvironmentMap* environmentMap = skyboxObject->GetEnvironmentMap())
+    {
+        // The previous sky stays until the conversion (or the read from the cache) finished
+        if (environmentMap->IsLoading())
+            return;
+        if (!environmentMap->HasData() && !environmentMap->GetMipLevels().empty())
+        {
+            // Released after an earlier upload
+            AssetManager::GetInstance().LoadEnvironmentMapAsync(environmentMap->GetPath());
+            return;
+        }
+        if (environmentMap->HasData())
+            skyboxProxy->SetEnvironmentMap(environmentMap);
+    }
+    else if (skyboxObject->HasAllTexturesSet())
+    {
+        // Faces that were only registered so far (e.g. after loading a scene) get imported first
+        std::vector<TextureAsset*> texturesToLoad;
+        bool allTexturesReady = true;
+        for (const auto textureAsset : skyboxObject->GetTextureAssets())
+        {
+            if (textureAsset && requestTexture(textureAsset, texturesToLoad))
+                allTexturesReady = false;
+        }
+        AssetManager::GetInstance().LoadTexturesAsync(texturesToLoad);
+        if (!allTexturesReady)
+            return;
+
         skyboxProxy->SetTextures(skyboxObject->GetTextureAssets());
+        for (const auto textureAsset : skyboxObject->GetTextureAssets())
+            m_RequestedTextureIds.erase(textureAsset->GetId());
+    }
 
     skyboxObject->SetDirtyFlag(false);
     skyboxProxy->GetDirtyFlag() = true;
 }
 
+void ProxyManager::updateReloadingTextures()
+{
+    std::erase_if(m_ReloadingTextures, [this](TextureAsset* const textureAsset) {
+        if (textureAsset->IsLoading())
+            return false;
+
+        // Both formats are created before the upload is reported, the residency policy may release the data then
+        bool isUploaded = false;
+        for (const bool isSRGB : {false, true})
+        {
+            if (const auto textureProxy = getTextureProxy(textureAsset->GetId(), isSRGB))
+                isUploaded |= textureProxy->CreateTextureFromAsset(textureAsset);
+        }
+        if (isUploaded)
+            AssetManager::GetInstance().OnTextureUploaded(textureAsset);
+        return true;
+    });
+}
+
+void ProxyManager::updateReloadingMeshes()
+{
+    std::erase_if(m_ReloadingMeshes, [this](MeshAsset* const meshAsset) {
+        if (meshAsset->IsLoading())
+            return false;
+
+        // A restore that failed keeps the previous buffers
+        const auto meshProxy = dynamic_cast<MeshProxy*>(GetProxy(meshAsset->GetId()));
+        if (meshProxy && meshProxy->CreateBuffers(meshAsset))
+            m_RequestedMeshIds.erase(meshAsset->GetId());
+        return true;
+    });
+}
+
+TextureProxy* ProxyManager::getTextureProxy(const uint32_t assetId, const bool isSRGB)
+{
+    const auto it = m_TextureProxies.find(getTextureProxyKey(assetId, isSRGB));
+    return it != m_TextureProxies.end() ? it->second.get() : nullptr;
+}
+
+bool ProxyManager::isTextureResident(const uint32_t assetId)
+{
+    for (const bool isSRGB : {false, true})
+    {
+        if (const auto textureProxy = getTextureProxy(assetId, isSRGB); textureProxy && textureProxy->IsResident())
+            return true;
+    }
+
+    return false;
+}
+
 void ProxyManager::updateSceneLightProxies(const uint32_t sceneLightId)
 {
     const auto lightObject = ECSRegistry::GetInstance().GetEntity<LightObject>(sceneLightId);
@@ -210,25 +414,89 @@ void ProxyManager::updateSceneLightProxies(const uint32_t sceneLightId)
     m_Proxies[sceneLightId]->GetDirtyFlag() = true;
 }
 
-void ProxyManager::setupMaterialProxy(const std::string& assetPath, TextureProxy** const textureProxy,
-                                      TextureAsset* const textureAsset,
-                                      TextureAsset* const alternativeTextureAsset)
+bool ProxyManager::setupMaterialProxy(const std::string& assetPath, TextureProxy** const textureProxy,
+                                      TextureAsset* const textureAsset, TextureAsset* const alternativeTextureAsset,
+                                      const MaterialTextureSlot slot, std::vector<TextureAsset*>& texturesToLoad)
 {
-    const auto assetToUse = assetPath.empty() && alternativeTextureAsset ? alternativeTextureAsset : textureAsset;
+    auto assetToUse = assetPath.empty() && alternativeTextureAsset ? alternativeTextureAsset : textureAsset;
+    const bool isSRGB = MaterialAsset::IsSRGBSlot(slot);
 
-    if (assetToUse)
+    bool isReady = true;
+    if (assetToUse && assetToUse != alternativeTextureAsset)
     {
-        const uint32_t assetId = assetToUse->GetId();
-        if (!m_Proxies.contains(assetId))
+        const auto existingProxy = getTextureProxy(assetToUse->GetId(), isSRGB);
+        if ((!existingProxy || !existingProxy->IsResident()) && requestTexture(assetToUse, texturesToLoad))
         {
-            m_Proxies[assetId] = CreateScope<TextureProxy>(assetId);
-            *textureProxy = dynamic_cast<TextureProxy*>(m_Proxies[assetId].get());
-            (*textureProxy)->CreateTextureFromAsset(assetToUse);
+            // Texture is not decoded yet, render with the placeholder in the meantime
+            assetToUse = alternativeTextureAsset;
+            *textureProxy = nullptr;
+            isReady = false;
         }
-        else
+    }
+
+    if (assetToUse)
+    {
+        const uint32_t assetId = assetToUse->GetId();
+        auto& proxy = m_TextureProxies[getTextureProxyKey(assetId, isSRGB)];
+        if (!proxy)
+            proxy = CreateScope<TextureProxy>(assetId, isSRGB);
+        *textureProxy = proxy.get();
+        // Placeholders are tiny, so they are created right away if they got evicted. Data that was released after
+        // an earlier upload is imported again first.
+        if (!(*textureProxy)->IsResident())
         {
-            *textureProxy = dynamic_cast<TextureProxy*>(m_Proxies[assetId].get());
+            if ((*textureProxy)->CreateTextureFromAsset(assetToUse))
+            {
+                AssetManager::GetInstance().OnTextureUploaded(assetToUse);
+                m_RequestedTextureIds.erase(assetId);
+            }
+            else if (requestTexture(assetToUse, texturesToLoad))
+                isReady = false;
         }
+        (*textureProxy)->SetLastUsedFrame(m_FrameIndex);
+    }
+
+    return isReady;
+}
+
+bool ProxyManager::requestTexture(TextureAsset* const textureAsset, std::vector<TextureAsset*>& texturesToLoad)
+{
+    const uint32_t assetId = textureAsset->GetId();
+    if (!textureAsset->IsLoading() && textureAsset->isUnloaded() && !m_RequestedTextureIds.contains(assetId))
+    {
+        m_RequestedTextureIds.insert(assetId);
+        texturesToLoad.push_back(textureAsset);
+    }
+
+    return textureAsset->IsLoading() || std::ranges::find(texturesToLoad, textureAsset) != texturesToLoad.end();
+}
+
+void ProxyManager::evictTextures(const size_t memoryBudget)
+{
+    size_t residentSize = 0;
+    std::vector<TextureProxy*> unusedTextures;
+    for (const auto& textureProxy : m_TextureProxies | std::views::values)
+    {
+        if (!textureProxy->IsResident())
+            continue;
+
+        residentSize += textureProxy->GetMemorySize();
+        if (textureProxy->GetLastUsedFrame() < m_FrameIndex)
+            unusedTextures.push_back(textureProxy.get());
+    }
+    if (residentSize <= memoryBudget)
+        return;
+
+    std::ranges::sort(unusedTextures, {}, &TextureProxy::GetLastUsedFrame);
+    for (const auto textureProxy : unusedTextures)
+    {
+        if (residentSize <= memoryBudget)
+            break;
+
+        SPDLOG_DEBUG("Evicting texture " + std::to_string(textureProxy->GetId()) + " (" +
+                     MemoryTracker::FormatSize(textureProxy->GetMemorySize()) + ")");
+        residentSize -= textureProxy->GetMemorySize();
+        textureProxy->Evict();
     }
 }
 
@@ -8,6 +8,12 @@
 #include "Rendering/Proxy/SkyboxProxy.h"
 #include "Rendering/Proxy/MeshProxy.h"
 #include "Rendering/Proxy/TextureProxy.h"
+#include "Rendering/Proxy/TransformHierarchy.h"
+#include "Entity/View.h"
+#include "Entity/Components/MeshComponent.h"
+#include "Entity/Components/MaterialComponent.h"
+
+#include <unordered_set>
 
 class ProxyManager
 {
@@ -15,6 +21,9 @@ public:
     ProxyManager();
 
     void UpdateProxies(const Scene* const scene);
+    // Updates the proxies of assets that were reloaded from disk in place. Textures keep their old content until the
+    // new data is decoded, so there is no stall
+    void ReloadAssets(const Scene* const scene, const AssetChanges& assetChanges);
     Proxy* GetProxy(const uint32_t id);
 
     std::vector<SceneObjectProxy*> GetSceneObjectsToRender(const Scene* const scene);
@@ -24,14 +33,46 @@ private:
     std::unordered_map<uint32_t, Scope<Proxy>> m_Proxies;
     std::vector<SceneObjectProxy*> m_SceneObjectsToRender;
     std::unordered_map<uint32_t, std::vector<SceneObjectProxy*>> m_SceneObjectsToRenderByMaterial;
+    // Everything with a mesh gets drawn
+    Query<MeshComponent, MaterialComponent> m_RenderableQuery;
+    TransformHierarchy m_TransformHierarchy;
+    // Keyed by asset id and color space, a texture used for color and for data (e.g. in a diffuse and in a roughness
+    // slot) gets a GPU texture in each format
+    std::unordered_map<uint64_t, Scope<TextureProxy>> m_TextureProxies;
+    // Textures whose import was started for a material, so a failed import isn't restarted every frame
+    std::unordered_set<uint32_t> m_RequestedTextureIds;
+    std::vector<TextureAsset*> m_ReloadingTextures;
+    // Meshes whose data was released after an earlier upload, restored in the background before their buffers are
+    // created. Requested once per mesh, like the textures.
+    std::unordered_set<uint32_t> m_RequestedMeshIds;
+    std::vector<MeshAsset*> m_MeshesToLoad;
+    std::vector<MeshAsset*> m_ReloadingMeshes;
+    uint64_t m_FrameIndex;
 
-    void updateSceneObjectProxy(const uint32_t sceneObjectId, SceneObjectProxy* const parentProxy);
+    // Resolves the mesh and material proxies, the model matrix comes from the transform hierarchy
+    void updateSceneObjectProxy(const uint32_t sceneObjectId);
     void updateMaterialProxy(const uint32_t materialId);
     void updateCameraProxy(const uint32_t cameraId);
     void updateSkyboxProxy(const uint32_t skyboxId);
     void updateSceneLightProxies(const uint32_t sceneLightId);
-    void setupMaterialProxy(const std::string& assetPath, TextureProxy** const textureProxy,
-                            TextureAsset* const textureAsset, TextureAsset* const alternativeTextureAsset);
+    void updateReloadingTextures();
+    void updateReloadingMeshes();
+    static uint64_t getTextureProxyKey(const uint32_t assetId, const bool isSRGB)
+    {
+        return static_cast<uint64_t>(assetId) << 1 | static_cast<uint64_t>(isSRGB);
+    }
+    TextureProxy* getTextureProxy(uint32_t assetId, bool isSRGB);
+    bool isTextureResident(uint32_t assetId);
+    // Returns nullptr while the data of the mesh is restored, the proxy is created in a later frame
+    MeshProxy* requestMeshProxy(MeshAsset* const meshAsset);
+    void requestMeshData(MeshAsset* const meshAsset);
+    bool setupMaterialProxy(const std::string& assetPath, TextureProxy** const textureProxy,
+                            TextureAsset* const textureAsset, TextureAsset* const alternativeTextureAsset,
+                            MaterialTextureSlot slot, std::vector<TextureAsset*>& texturesToLoad);
+    // Queues the import of a texture that was only registered so far. Returns true while it isn't decoded yet
+    bool requestTexture(TextureAsset* const textureAsset, std::vector<TextureAsset*>& texturesToLoad);
+    // Frees the least recently used textures that weren't drawn this frame until the budget is met
+    void evictTextures(size_t memoryBudget);
 
     void addSceneObjectProxyAndChildrenToList(std::vector<SceneObjectProxy*>& list,
                                               const SceneObject* const sceneObject);
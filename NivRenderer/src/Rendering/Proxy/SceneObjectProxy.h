@@ -11,7 +11,7 @@ public:
 
     ~SceneObjectProxy() override;
 
-    void SetTransform(glm::vec3 position, glm::vec3 scale, glm::vec3 rotation);
+    void SetModelMatrix(const glm::mat4& modelMatrix) { m_ModelMatrix = modelMatrix; }
     void SetMesh(MeshProxy* const meshProxy);
     void SetMaterial(MaterialProxy* const materialProxy);
     void Bind() const;
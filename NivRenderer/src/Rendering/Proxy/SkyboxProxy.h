@@ -1,11 +1,14 @@
 #pragma once
 #include "Base.h"
 #include "Rendering/Proxy/Proxy.h"
+#include "Rendering/Proxy/TextureProxy.h"
+#include "Application/Util/MemoryTracker.h"
+#include "Entity/Assets/AssetManager.h"
 
 class SkyboxProxy : public Proxy
 {
 public:
-    SkyboxProxy(uint32_t id) : Proxy(id), m_Texture(UINT32_MAX)
+    SkyboxProxy(uint32_t id) : Proxy(id), m_Texture(UINT32_MAX), m_IsHdr(0)
     {
         float skyboxVertices[] = {// positions
                                   -1.0f, 1.0f,  -1.0f, -1.0f, -1.0f, -1.0f, 1.0f,  -1.0f, -1.0f,
@@ -42,6 +45,7 @@ public:
         glDeleteBuffers(1, &m_VertexBuffer);
         glDeleteVertexArrays(1, &m_VertexArray);
         glDeleteTextures(1, &m_Texture);
+        MemoryTracker::GetInstance().Untrack("Textures", GetId());
     }
 
     void SetTextures(const std::array<TextureAsset*, 6>& textures)
@@ -50,33 +54,37 @@ public:
             glDeleteTextures(1, &m_Texture);
 
         glCreateTextures(GL_TEXTURE_CUBE_MAP, 1, &m_Texture);
-        GLenum format;
-        GLenum sizedFormat;
-        switch (*textures[0]->GetNrComponents())
+        // Skybox faces are color data, so they always get an sRGB format
+        const GLenum internalFormat = TextureProxy::SelectInternalFormat(textures[0], true);
+        if (textures[0]->IsCompressed())
         {
-        case 1:
-            format = GL_RED;
-            sizedFormat = GL_R16;
-            break;
-        case 3:
-            format = GL_RGB;
-            sizedFormat = GL_RGB16;
-            break;
-        case 4:
-        default:
-            format = GL_RGBA;
-            sizedFormat = GL_RGBA16;
-            break;
+            // Only the base level is used for the skybox
+            const auto& baseLevel = textures[0]->GetMipLevels()[0];
+            glTextureStorage2D(m_Texture, 1, internalFormat, baseLevel.Width, baseLevel.Height);
+            uint8_t i = 0;
+            for (auto& textureAsset : textures)
+            {
+                const auto& mipLevel = textureAsset->GetMipLevels()[0];
+                glCompressedTextureSubImage3D(m_Texture, 0, 0, 0, i, mipLevel.Width, mipLevel.Height, 1, internalFormat,
+                                              static_cast<GLsizei>(mipLevel.Size),
+                                              textureAsset->GetCompressedData().GetData() + mipLevel.Offset);
+                i++;
+            }
         }
-
-        glTextureStorage2D(m_Texture, 1, sizedFormat, *textures[0]->GetWidth(), *textures[0]->GetHeight());
-        uint8_t i = 0;
-        for (auto& textureAsset : textures)
+        else
         {
-            glTextureSubImage3D(m_Texture, 0, 0, 0, i, *textureAsset->GetWidth(), *textureAsset->GetHeight(), 1, format,
-                                GL_UNSIGNED_BYTE, textureAsset->GetTextureData());
-            i++;
+            const GLenum format = TextureProxy::GetPixelFormat(*textures[0]->GetNrComponents());
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+            glTextureStorage2D(m_Texture, 1, internalFormat, *textures[0]->GetWidth(), *textures[0]->GetHeight());
+            uint8_t i = 0;
+            for (auto& textureAsset : textures)
+            {
+                glTextureSubImage3D(m_Texture, 0, 0, 0, i, *textureAsset->GetWidth(), *textureAsset->GetHeight(), 1, format,
+                                    GL_UNSIGNED_BYTE, textureAsset->GetTextureData());
+                i++;
+            }
         }
+        MemoryTracker::GetInstance().Track("Textures", GetId(), "Skybox", TextureProxy::CalculateMemorySize(textures[0], 1) * 6);
         glTextureParameteri(m_Texture, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         glTextureParameteri(m_Texture, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
         glTextureParameteri(m_Texture, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
@@ -84,6 +92,40 @@ public:
         glTextureParameteri(m_Texture, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
         glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+        m_IsHdr = 0;
+
+        for (const auto textureAsset : textures)
+            AssetManager::GetInstance().OnTextureUploaded(textureAsset);
+    }
+
+    void SetEnvironmentMap(EnvironmentMap* environmentMap)
+    {
+        if (m_Texture != UINT32_MAX)
+            glDeleteTextures(1, &m_Texture);
+
+        glCreateTextures(GL_TEXTURE_CUBE_MAP, 1, &m_Texture);
+        const auto& mipLevels = environmentMap->GetMipLevels();
+        glTextureStorage2D(m_Texture, static_cast<GLsizei>(mipLevels.size()), GL_RGB16F, environmentMap->GetFaceSize(),
+                           environmentMap->GetFaceSize());
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        size_t memorySize = 0;
+        for (size_t level = 0; level < mipLevels.size(); level++)
+        {
+            // All six faces of a level are next to each other
+            const auto& mipLevel = mipLevels[level];
+            glTextureSubImage3D(m_Texture, static_cast<GLint>(level), 0, 0, 0, mipLevel.Width, mipLevel.Height, 6, GL_RGB,
+                                GL_HALF_FLOAT, environmentMap->GetData().GetData() + mipLevel.Offset);
+            memorySize += mipLevel.Size;
+        }
+        MemoryTracker::GetInstance().Track("Textures", GetId(), "Skybox", memorySize);
+        glTextureParameteri(m_Texture, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTextureParameteri(m_Texture, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTextureParameteri(m_Texture, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+        glTextureParameteri(m_Texture, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTextureParameteri(m_Texture, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        m_IsHdr = 1;
+
+        AssetManager::GetInstance().OnEnvironmentMapUploaded(environmentMap);
     }
 
     void Bind() const
@@ -106,9 +148,12 @@ public:
 
     uint32_t GetVertexArrayId() const { return m_VertexArray; }
     uint32_t GetTextureId() const { return m_Texture; }
+    // 1 if the cubemap holds linear HDR values that have to be tonemapped, an int so it can be bound as uniform
+    const int32_t* GetIsHdr() const { return &m_IsHdr; }
 
 private:
     // TODO: Abstract
     uint32_t m_Texture;
     uint32_t m_VertexBuffer, m_VertexArray;
+    int32_t m_IsHdr;
 };
\ No newline at end of file
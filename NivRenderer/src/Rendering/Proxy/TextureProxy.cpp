@@ -1,48 +1,158 @@
 #include "TextureProxy.h"
 
-TextureProxy::TextureProxy(const uint32_t id)
-    : Proxy(id)
+#include "Application/Util/MemoryTracker.h"
+
+TextureProxy::TextureProxy(const uint32_t id, const bool isSRGB)
+    : Proxy(id), m_MemorySize(0), m_IsResident(false), m_IsSRGB(isSRGB), m_LastUsedFrame(0)
 {
     glCreateTextures(GL_TEXTURE_2D, 1, &m_TextureId);
 }
 
-TextureProxy::~TextureProxy() = default;
+TextureProxy::~TextureProxy()
+{
+    glDeleteTextures(1, &m_TextureId);
+    MemoryTracker::GetInstance().Untrack(getMemoryCategory(), GetId());
+}
 
-void TextureProxy::CreateTextureFromAsset(TextureAsset* const textureAsset) const
+bool TextureProxy::CreateTextureFromAsset(TextureAsset* const textureAsset)
 {
-    if (textureAsset->isUnloaded())
-        textureAsset->ReloadData();
+    if (textureAsset->isUnloaded() || textureAsset->IsLoading())
+        return false;
+    // Immutable storage can't be respecified, so a texture that was created before needs a new object
+    if (m_IsResident)
+        Evict();
+
+    const GLenum internalFormat = SelectInternalFormat(textureAsset, m_IsSRGB);
+    if (textureAsset->IsCompressed())
+    {
+        const auto& mipLevels = textureAsset->GetMipLevels();
+        const unsigned char* data = textureAsset->GetCompressedData().GetData();
+
+        glTextureStorage2D(m_TextureId, static_cast<GLsizei>(mipLevels.size()), internalFormat,
+                           mipLevels[0].Width, mipLevels[0].Height);
+        for (size_t level = 0; level < mipLevels.size(); level++)
+        {
+            const auto& mipLevel = mipLevels[level];
+            glCompressedTextureSubImage2D(m_TextureId, static_cast<GLint>(level), 0, 0, mipLevel.Width, mipLevel.Height,
+                                          internalFormat, static_cast<GLsizei>(mipLevel.Size), data + mipLevel.Offset);
+        }
+        m_MemorySize = CalculateMemorySize(textureAsset, static_cast<int32_t>(mipLevels.size()));
+    }
+    else
+    {
+        const int32_t mipLevelCount = GetMipLevelCount(*textureAsset->GetWidth(), *textureAsset->GetHeight());
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTextureStorage2D(m_TextureId, mipLevelCount, internalFormat, *textureAsset->GetWidth(), *textureAsset->GetHeight());
+        glTextureSubImage2D(m_TextureId, 0, 0, 0, *textureAsset->GetWidth(), *textureAsset->GetHeight(),
+                            GetPixelFormat(*textureAsset->GetNrComponents()), GL_UNSIGNED_BYTE,
+                            textureAsset->GetTextureData());
+        glGenerateTextureMipmap(m_TextureId);
+        m_MemorySize = CalculateMemorySize(textureAsset, mipLevelCount);
+    }
+
+    glTextureParameteri(m_TextureId, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTextureParameteri(m_TextureId, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTextureParameteri(m_TextureId, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTextureParameteri(m_TextureId, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    MemoryTracker::GetInstance().Track(getMemoryCategory(), GetId(), textureAsset->GetPath(), m_MemorySize);
+    m_IsResident = true;
+
+    return true;
+}
+
+void TextureProxy::Evict()
+{
+    glDeleteTextures(1, &m_TextureId);
+    glCreateTextures(GL_TEXTURE_2D, 1, &m_TextureId);
+    MemoryTracker::GetInstance().Untrack(getMemoryCategory(), GetId());
+    m_MemorySize = 0;
+    m_IsResident = false;
+}
+
+GLenum TextureProxy::SelectInternalFormat(TextureAsset* const textureAsset, const bool isSRGB)
+{
+    if (textureAsset->IsCompressed())
+        return GetCompressedFormat(textureAsset->GetCompressionFormat(), isSRGB);
 
-    GLenum format;
-    GLenum sizedFormat;
     switch (*textureAsset->GetNrComponents())
     {
     case 1:
-        format = GL_RED;
-        sizedFormat = GL_R16;
-        break;
+        return GL_R8;
+    case 2:
+        return GL_RG8;
     case 3:
-        format = GL_RGB;
-        sizedFormat = GL_RGB16;
-        break;
+        return isSRGB ? GL_SRGB8 : GL_RGB8;
     case 4:
     default:
-        format = GL_RGBA;
-        sizedFormat = GL_RGBA16;
-        break;
+        return isSRGB ? GL_SRGB8_ALPHA8 : GL_RGBA8;
     }
+}
 
-    glTextureStorage2D(m_TextureId, 1, sizedFormat, *textureAsset->GetWidth(), *textureAsset->GetHeight());
-    glTextureSubImage2D(m_TextureId, 0, 0, 0, *textureAsset->GetWidth(), *textureAsset->GetHeight(), format,
-                        GL_UNSIGNED_BYTE, textureAsset->GetTextureData());
-    glGenerateTextureMipmap(m_TextureId);
+GLenum TextureProxy::GetPixelFormat(const int32_t nrComponents)
+{
+    switch (nrComponents)
+    {
+    case 1:
+        return GL_RED;
+    case 2:
+        return GL_RG;
+    case 3:
+        return GL_RGB;
+    case 4:
+    default:
+        return GL_RGBA;
+    }
+}
 
-    glTextureParameteri(m_TextureId, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTextureParameteri(m_TextureId, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    glTextureParameteri(m_TextureId, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-    glTextureParameteri(m_TextureId, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+GLenum TextureProxy::GetCompressedFormat(const BlockCompression::Format format, const bool isSRGB)
+{
+    // RGTC has no sRGB variant, single and two channel textures always hold linear data
+    switch (format)
+    {
+    case BlockCompression::Format::BC4:
+        return GL_COMPRESSED_RED_RGTC1;
+    case BlockCompression::Format::BC5:
+        return GL_COMPRESSED_RG_RGTC2;
+    case BlockCompression::Format::BC7:
+    default:
+        return isSRGB ? GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM : GL_COMPRESSED_RGBA_BPTC_UNORM;
+    }
+}
+
+int32_t TextureProxy::GetMipLevelCount(const int32_t width, const int32_t height)
+{
+    int32_t mipLevelCount = 1;
+    for (int32_t size = std::max(width, height); size > 1; size /= 2)
+        mipLevelCount++;
+
+    return mipLevelCount;
+}
+
+size_t TextureProxy::CalculateMemorySize(TextureAsset* const textureAsset, const int32_t mipLevelCount)
+{
+    size_t memorySize = 0;
+    if (textureAsset->IsCompressed())
+    {
+        const auto& mipLevels = textureAsset->GetMipLevels();
+        for (int32_t level = 0; level < mipLevelCount && level < static_cast<int32_t>(mipLevels.size()); level++)
+            memorySize += mipLevels[level].Size;
+
+        return memorySize;
+    }
+
+    // The driver pads three channel textures to four channels
+    const size_t bytesPerPixel = *textureAsset->GetNrComponents() == 3 ? 4 : *textureAsset->GetNrComponents();
+    int32_t width = *textureAsset->GetWidth();
+    int32_t height = *textureAsset->GetHeight();
+    for (int32_t level = 0; level < mipLevelCount; level++)
+    {
+        memorySize += static_cast<size_t>(width) * height * bytesPerPixel;
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+    }
 
-    textureAsset->UnloadData();
+    return memorySize;
 }
 
 void TextureProxy::BindToSlot(uint32_t slot) const
@@ -6,15 +6,40 @@
 class TextureProxy : public Proxy
 {
 public:
-    TextureProxy(const uint32_t id);
+    // The id is the one of the texture asset, isSRGB picks the format the data is sampled with
+    TextureProxy(const uint32_t id, bool isSRGB);
     ~TextureProxy();
 
-    void CreateTextureFromAsset(TextureAsset* const textureAsset) const;
+    // Returns false without touching the texture while the data of the asset is unloaded or still being imported.
+    // The caller reports the upload with AssetManager::OnTextureUploaded, after every proxy of the asset was created.
+    bool CreateTextureFromAsset(TextureAsset* const textureAsset);
+    // Frees the GPU storage, the texture has to be created from its asset again before it can be bound
+    void Evict();
+
+    // Picks the GPU storage format for a texture, 8-bit data stays 8-bit and color data gets an sRGB format
+    static GLenum SelectInternalFormat(TextureAsset* const textureAsset, bool isSRGB);
+    static GLenum GetPixelFormat(int32_t nrComponents);
+    static GLenum GetCompressedFormat(BlockCompression::Format format, bool isSRGB);
+    static int32_t GetMipLevelCount(int32_t width, int32_t height);
+    // Size of the texture including the given amount of mip levels
+    static size_t CalculateMemorySize(TextureAsset* const textureAsset, int32_t mipLevelCount);
 
     void BindToSlot(uint32_t slot) const;
     uint32_t GetTextureId() const { return m_TextureId; }
+    size_t GetMemorySize() const { return m_MemorySize; }
+    bool IsResident() const { return m_IsResident; }
+    bool IsSRGB() const { return m_IsSRGB; }
+    uint64_t GetLastUsedFrame() const { return m_LastUsedFrame; }
+    void SetLastUsedFrame(const uint64_t frame) { m_LastUsedFrame = frame; }
 
 private:
     //TODO: Abstract
     uint32_t m_TextureId;
-};
\ No newline at end of file
+    size_t m_MemorySize;
+    bool m_IsResident;
+    bool m_IsSRGB;
+    uint64_t m_LastUsedFrame;
+
+    // Both formats of a texture can be on the GPU, they are tracked separately
+    const char* getMemoryCategory() const { return m_IsSRGB ? "Textures (sRGB)" : "Textures"; }
+};
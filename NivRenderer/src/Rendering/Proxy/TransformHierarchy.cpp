@@ -0,0 +1,102 @@
+#include "Rendering/Proxy/TransformHierarchy.h"
+
+#include "Entity/ECSRegistry.h"
+
+#include <ranges>
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/euler_angles.hpp>
+
+TransformHierarchy::TransformHierarchy() : m_Scene(nullptr), m_StructureVersion(UINT64_MAX) {}
+
+void TransformHierarchy::Update(const Scene* const scene)
+{
+    if (scene != m_Scene || m_StructureVersion != ECSRegistry::GetInstance().GetStructureVersion())
+    {
+        rebuild(scene);
+        std::ranges::fill(m_LocalMatrixChanged, 1);
+    }
+    else
+    {
+        // Only transform writes matter here, edits of other components or of the entity leave the matrices alone
+        for (const uint32_t entityId : ECSRegistry::GetInstance().GetChangedEntityIds<TransformComponent>())
+        {
+            if (entityId < m_NodeIndices.size() && m_NodeIndices[entityId] != INVALID_NODE)
+                m_LocalMatrixChanged[m_NodeIndices[entityId]] = 1;
+        }
+    }
+
+    for (size_t node = 0; node < m_EntityIds.size(); node++)
+    {
+        const int32_t parent = m_ParentIndices[node];
+        const bool localChanged = m_LocalMatrixChanged[node];
+        const bool changed = localChanged || (parent != -1 && m_WorldMatrixChanged[parent]);
+        m_WorldMatrixChanged[node] = changed;
+        if (!changed)
+            continue;
+
+        if (localChanged)
+        {
+            m_LocalMatrixChanged[node] = 0;
+            TransformComponent* transform = m_TransformComponents[node];
+            m_LocalMatrices[node] = transform ? ComposeTransform(transform->GetPosition(), transform->GetScale(),
+                                                                 transform->GetRotation())
+                                              : glm::mat4(1.0f);
+        }
+        m_WorldMatrices[node] = parent == -1 ? m_LocalMatrices[node] : m_WorldMatrices[parent] * m_LocalMatrices[node];
+    }
+}
+
+glm::mat4 TransformHierarchy::ComposeTransform(const glm::vec3& position, const glm::vec3& scale,
+                                               const glm::vec3& rotation)
+{
+    // Same as translate * rotateY * rotateX * rotateZ * scale, without the matrix multiplications
+    glm::mat4 transform = glm::eulerAngleYXZ(rotation.y, rotation.x, rotation.z);
+    transform[0] *= scale.x;
+    transform[1] *= scale.y;
+    transform[2] *= scale.z;
+    transform[3] = glm::vec4(position, 1.0f);
+
+    return transform;
+}
+
+void TransformHierarchy::rebuild(const Scene* const scene)
+{
+    m_Scene = scene;
+    m_StructureVersion = ECSRegistry::GetInstance().GetStructureVersion();
+
+    m_EntityIds.clear();
+    m_Entities.clear();
+    m_ParentIndices.clear();
+    m_TransformComponents.clear();
+    m_NodeIndices.clear();
+
+    // Depth first, so parents are always stored before their children
+    std::vector<std::pair<Entity*, int32_t>> pendingNodes;
+    for (const uint32_t sceneObjectId : scene->GetSceneObjectIds() | std::views::reverse)
+        pendingNodes.emplace_back(ECSRegistry::GetInstance().GetEntity<Entity>(sceneObjectId), -1);
+
+    while (!pendingNodes.empty())
+    {
+        const auto [entity, parent] = pendingNodes.back();
+        pendingNodes.pop_back();
+
+        const auto node = static_cast<int32_t>(m_EntityIds.size());
+        if (entity->GetId() >= m_NodeIndices.size())
+            m_NodeIndices.resize(static_cast<size_t>(entity->GetId()) + 1, INVALID_NODE);
+        m_NodeIndices[entity->GetId()] = static_cast<uint32_t>(node);
+        m_EntityIds.push_back(entity->GetId());
+        m_Entities.push_back(entity);
+        m_ParentIndices.push_back(parent);
+        m_TransformComponents.push_back(ECSRegistry::GetInstance().GetComponent<TransformComponent>(entity->GetId()));
+
+        const auto& childEntities = entity->GetChildEntities();
+        for (auto it = childEntities.rbegin(); it != childEntities.rend(); ++it)
+            pendingNodes.emplace_back(*it, node);
+    }
+
+    m_LocalMatrices.resize(m_EntityIds.size());
+    m_WorldMatrices.resize(m_EntityIds.size());
+    m_WorldMatrixChanged.resize(m_EntityIds.size());
+    m_LocalMatrixChanged.resize(m_EntityIds.size());
+}
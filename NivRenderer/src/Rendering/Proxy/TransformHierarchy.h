@@ -0,0 +1,46 @@
+#pragma once
+#include "Base.h"
+#include "Application/Scene.h"
+#include "Entity/Components/TransformComponent.h"
+
+// The scene object hierarchy flattened into arrays that are sorted so every parent comes before its children. World
+// matrices are computed in a single linear pass that only touches nodes whose transform component changed and the
+// subtrees below them. The order is only rebuilt after entities or components were added or removed.
+class TransformHierarchy
+{
+public:
+    TransformHierarchy();
+
+    void Update(const Scene* const scene);
+
+    size_t GetSize() const { return m_EntityIds.size(); }
+    uint32_t GetEntityId(const size_t node) const { return m_EntityIds[node]; }
+    Entity* GetEntity(const size_t node) const { return m_Entities[node]; }
+    const glm::mat4& GetWorldMatrix(const size_t node) const { return m_WorldMatrices[node]; }
+    // Whether the world matrix was recomputed by the last Update
+    bool IsWorldMatrixChanged(const size_t node) const { return m_WorldMatrixChanged[node]; }
+
+    // Translation * rotation (Y, X, Z order) * scale, rotation in radians
+    static glm::mat4 ComposeTransform(const glm::vec3& position, const glm::vec3& scale, const glm::vec3& rotation);
+
+private:
+    static constexpr uint32_t INVALID_NODE = UINT32_MAX;
+
+    void rebuild(const Scene* const scene);
+
+    std::vector<uint32_t> m_EntityIds;
+    std::vector<Entity*> m_Entities;
+    // -1 for the root objects of the scene
+    std::vector<int32_t> m_ParentIndices;
+    // nullptr for objects without a transform, which take over the world matrix of their parent
+    std::vector<TransformComponent*> m_TransformComponents;
+    std::vector<glm::mat4> m_LocalMatrices;
+    std::vector<glm::mat4> m_WorldMatrices;
+    std::vector<uint8_t> m_LocalMatrixChanged;
+    std::vector<uint8_t> m_WorldMatrixChanged;
+    // Entity id -> node
+    std::vector<uint32_t> m_NodeIndices;
+
+    const Scene* m_Scene;
+    uint64_t m_StructureVersion;
+};
@@ -130,6 +130,8 @@ struct RenderCommand
     CommandType Type;
     RendererState State;
     uint32_t VertexIndexCount;
+    // Offset into the bound index buffer for DRAW_INDEXED, in indices
+    uint32_t FirstIndex = 0;
     size_t StateHash = State.GetHash();
 };
 
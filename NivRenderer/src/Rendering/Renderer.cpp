@@ -32,7 +32,9 @@ void Renderer::PrepareFrame() const
     if (m_Scene->GetSceneSettings().animateDirectionalLight)
         AnimateDirectionalLight();
 
+    m_ProxyManager->ReloadAssets(m_Scene.get(), AssetManager::GetInstance().ProcessFileChanges());
     m_ProxyManager->UpdateProxies(m_Scene.get());
+    AssetManager::GetInstance().UpdateResidency();
 }
 
 void Renderer::RenderScene() const